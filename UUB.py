@@ -5,15 +5,18 @@
  Implementation of UUB dispatcher & UUB meas
 """
 
+import ctypes
 import http.client
 import logging
+import os
 import re
 import socket
 import select
 import threading
+from collections import OrderedDict
 from datetime import datetime, timedelta
 from time import sleep
-from struct import unpack
+from struct import pack, unpack
 from struct import error as struct_error
 import telnetlib
 import numpy as np
@@ -26,6 +29,7 @@ HTTPPORT = 80
 DATAPORT = 8888    # UDP port UUB send data to
 CTRLPORT = 8887    # UDP port UUB listen for commands
 ADCPORT = 8886     # UDP port adcramp on UUB communicates
+AGENTPORT = 8885   # UDP port uubagent on UUB listens for commands
 LADDR = "192.168.31.254"  # IP address of the computer
 VIRGINMAC = '00:0a:35:00:1e:53'
 VIRGINIP = '192.168.31.0'
@@ -540,9 +544,24 @@ q_ndata - a queue to send received data (NetscopeData instance)"""
         # adjust before run
         self.port = DATAPORT
         self.laddr = LADDR
-        self.PACKETSIZE = 1500
+        # multicast group netscope sends to (-d or NetscopeCtrl.addDest),
+        # joined on laddr interface; several listeners may share it
+        self.mcast = None
+        # max. datagram size, netscope -m or NetscopeCtrl.fragsize()
+        self.PACKETSIZE = 9000
         self.RCVBUF = 1000000  # size of UDP socket recv buffer in bytes
         self.SLEEPTIME = 0.01  # timeout for checking active event
+        self.NACKTIME = 0.02   # time without progress before NACK
+        self.NACKMAX = 3       # max. number of NACKs per record
+        self.NACKRANGES = 16   # max. byte ranges in NACK (CTRL_MAXARGS)
+        self.NRECENT = 1024    # completed keys kept to drop late datagrams
+        # flow control (NetscopeCtrl.credit) each CREDITTIME: UUBs in
+        # uubnums granted CREDIT records less those waiting in q_ndata,
+        # CREDITBYTES bytes (keep below RCVBUF); None: not granted
+        self.CREDIT = None
+        self.CREDITBYTES = None
+        self.CREDITTIME = 0.1
+        self.CREDITDROP = False  # out of credit netscope drops events
         self.NPOINT = 2048    # number of measured points
         self.details = None
         self.uubnums = set()  # UUBs to monitor
@@ -551,18 +570,163 @@ q_ndata - a queue to send received data (NetscopeData instance)"""
         self.clear = False    # when True, discard all records
         self.logrecords = False    # when True, log records before discarding
         self.records = {}
+        self.nacks = {}  # key: [time of last progress or NACK, NACKs sent]
+        self.recent = OrderedDict()  # keys of the last completed records
+        # (UUBnum, port, block): {adc: NetscopeData} of averaged blocks
+        self.averages = {}
+        self.nacksock = None
+        self.credittime = 0  # timestamp of the last credit grant
+        self.q_stats = None  # if not None, a queue for NetscopeStats
+        self.q_rates = None  # if not None, a queue for NetscopeRates
+        # reassemble by libnsrecv.so (NetscopeRecv) instead of Python:
+        # True for the default library, or its path
+        self.native = None
+
+    def _sendnack(self, key, ranges, logger):
+        """Send NACK of ranges [start0, end0, ...] for key (UUBnum, port, id)
+"""
+        msg = pack('<%dL' % (2 + len(ranges)),
+                   NetscopeCtrl.CTRL_NACK, key[2], *ranges)
+        self.nacksock.sendto(msg, (uubnum2ip(key[0]), CTRLPORT))
+        logger.debug('NACK UUB %d, port %d, id %08x: %s',
+                     *(key + (repr(ranges), )))
+
+    def _credit(self, logger):
+        """Grant credit to UUBs in uubnums each CREDITTIME, the same
+to all of them; netscope sets it, so a lost grant is renewed by the
+next one"""
+        now = datetime.now().timestamp()
+        if self.CREDIT is None or not self.uubnums or \
+           now - self.credittime < self.CREDITTIME:
+            return
+        self.credittime = now
+        uubnums = list(self.uubnums)
+        events = max(0, self.CREDIT - self.q_ndata.qsize()) // len(uubnums)
+        nbytes = NetscopeCtrl.CREDIT_NOLIMIT if self.CREDITBYTES is None \
+            else self.CREDITBYTES // len(uubnums)
+        policy = NetscopeCtrl.CREDIT_DROP if self.CREDITDROP \
+            else NetscopeCtrl.CREDIT_HOLD
+        msg = pack('<4L', NetscopeCtrl.CTRL_CREDIT, events, nbytes, policy)
+        for uubnum in uubnums:
+            self.nacksock.sendto(msg, (uubnum2ip(uubnum), CTRLPORT))
+        logger.debug('credit %d events, %d bytes to UUBs %s',
+                     events, nbytes, repr(uubnums))
+        self._discardreplies()
+
+    def _discardreplies(self):
+        """Discard replies to NACKs and credit grants"""
+        try:
+            while True:
+                self.nacksock.recv(self.PACKETSIZE)
+        except (BlockingIOError, socket.timeout):
+            pass
+
+    def _discard(self, key):
+        """Remove UUBnum of record key from uubnums if not permanent,
+after the last event of averaged block"""
+        part = NetscopeData.averagePart(key[2])
+        if not self.permanent and (
+                part is None or part[1] == NetscopeData.NADC - 1):
+            self.uubnums.discard(key[0])
+
+    def _putdata(self, nd, key, logger):
+        """Send completed record to q_ndata, events of averaged block
+merged into one record when all are there"""
+        part = NetscopeData.averagePart(nd.id) if nd.isAverage() else None
+        if part is not None:
+            nd.release()
+            akey = key[:2] + (part[0], )
+            parts = self.averages.setdefault(akey, {})
+            parts[part[1]] = nd
+            if len(parts) < NetscopeData.NADC:
+                return
+            nd = NetscopeData.mergeAverage(
+                [parts[adc] for adc in range(NetscopeData.NADC)])
+            # drop incomplete blocks before this one
+            for k in [k for k in self.averages
+                      if k[:2] == akey[:2] and k[2] <= akey[2]]:
+                del self.averages[k]
+            logger.info('done averaged block UUB %d, port %d, block %d',
+                        *akey)
+        self.q_ndata.put(nd)
+
+    def _done(self, key, logger):
+        """Send completed record key to q_ndata"""
+        nd = self.records.pop(key)
+        self.nacks.pop(key, None)
+        self.recent[key] = None
+        if len(self.recent) > self.NRECENT:
+            self.recent.popitem(last=False)
+        nd.cover = None
+        self._putdata(nd, key, logger)
+        logger.info('done record UUB %d, port %d, id %08x', *key)
+        self._credit(logger)
+        if not self.uubnums and not self.records:
+            self.done.set()
+
+    def _rates(self, data, uubnum, logger):
+        """Pass rates datagram to q_rates"""
+        try:
+            rates = NetscopeRates(data, uubnum)
+        except struct_error:
+            logger.error('rates length error (%d) from UUB %d',
+                         len(data), uubnum)
+            return
+        logger.debug('rates UUB %d: %s', uubnum, rates)
+        if self.q_rates is not None:
+            self.q_rates.put(rates)
+
+    def _nack(self, logger):
+        """Ask netscope to resend missing chunks of stalled records (or whole
+event if only orphan chunks arrived)"""
+        now = datetime.now().timestamp()
+        for key, tn in list(self.nacks.items()):
+            if now - tn[0] < self.NACKTIME:
+                continue
+            if tn[1] >= self.NACKMAX or (
+                    key not in self.records and key[0] not in self.uubnums):
+                del self.nacks[key]
+                continue
+            ranges = []
+            if key in self.records:
+                for r in self.records[key].cover.missing()[:self.NACKRANGES]:
+                    ranges.extend(r)
+            self._sendnack(key, ranges, logger)
+            tn[0] = now
+            tn[1] += 1
+        self._discardreplies()
 
     def run(self):
         logger = logging.getLogger('UUBlisten')
         tid = syscall(SYS_gettid)
         logger.debug('run start, name %s, tid %d',
                      threading.current_thread().name, tid)
+        if self.native:
+            self._run_native(logger)
+            return
         self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
-        self.sock.bind((self.laddr, self.port))
+        if self.mcast is not None:
+            self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+            self.sock.bind((self.mcast, self.port))
+            mreq = socket.inet_aton(self.mcast) + socket.inet_aton(self.laddr)
+            self.sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP,
+                                 mreq)
+        else:
+            self.sock.bind((self.laddr, self.port))
         self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, self.RCVBUF)
         self.sock.settimeout(self.SLEEPTIME)
-        logger.info("Listening on %s:%d", self.laddr, self.port)
+        self.nacksock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.nacksock.setblocking(False)
+        logger.info("Listening on %s:%d", self.mcast or self.laddr, self.port)
+        checktime = 0  # timestamp of the last NACK and credit check
         while not self.stop.is_set():
+            # each SLEEPTIME, also while datagrams keep arriving
+            now = datetime.now().timestamp()
+            if now - checktime >= self.SLEEPTIME:
+                checktime = now
+                if self.nacks:
+                    self._nack(logger)
+                self._credit(logger)
             try:
                 data, addr = self.sock.recvfrom(self.PACKETSIZE)
             except socket.timeout:
@@ -578,14 +742,36 @@ q_ndata - a queue to send received data (NetscopeData instance)"""
                         logger.debug('Discarding records: { %s }', reclog)
                         self.logrecords = False
                     self.records = {}
+                    self.nacks = {}
+                    self.recent = OrderedDict()
+                    self.averages = {}
                     self.clear = False
                     self.cleared.set()
             nsid = unpack('<L', data[:4])[0]
             uubnum = ip2uubnum(addr[0])
+            if nsid == NetscopeRates.MAGIC:
+                self._rates(data, uubnum, logger)
+                continue
+            if nsid == NetscopeStats.MAGIC:
+                try:
+                    stats = NetscopeStats(data, uubnum)
+                except struct_error:
+                    logger.error('stats length error (%d) from UUB %d',
+                                 len(data), uubnum)
+                    continue
+                logger.info('stats UUB %d: %s', uubnum, stats)
+                if self.q_stats is not None:
+                    self.q_stats.put(stats)
+                continue
             # (UUBnum, port, id)
             key = (uubnum, addr[1], nsid & 0x7FFFFFFF)
             # logger.debug('packet UUB %d, port %d, id %08x',
             #              key[0], key[1], nsid)
+            if key in self.recent:
+                # resent or duplicated after completion
+                logger.debug('late datagram for UUB %d, port %d, id %08x',
+                             *key)
+                continue
             if nsid & 0x80000000:  # header
                 if key in self.records:
                     logger.error('duplicate header (UUB %d, port %d, id %08x)',
@@ -599,11 +785,14 @@ q_ndata - a queue to send received data (NetscopeData instance)"""
                     try:
                         self.records[key] = NetscopeData(data, uubnum,
                                                          self.details)
-                        if not self.permanent:
-                            self.uubnums.discard(uubnum)
+                        self.nacks[key] = [datetime.now().timestamp(), 0]
+                        self._discard(key)
                         logger.info(
                             'new record UUB %d, port %d, id %08x, rd%d',
                             key[0], key[1], key[2], self.records[key].rd)
+                        # no chunks follow an empty payload
+                        if self.records[key].size == 0:
+                            self._done(key, logger)
                     except struct_error:
                         logger.error('header length error (%d) ' +
                                      'from UUB %d, port %d, id %08x',
@@ -612,25 +801,100 @@ q_ndata - a queue to send received data (NetscopeData instance)"""
                 if key in self.records:
                     try:
                         if self.records[key].addChunk(data):
-                            # send to q_ndata
-                            nd = self.records.pop(key)
-                            nd.cover = None
-                            self.q_ndata.put(nd)
-                            logger.info('done record UUB %d, port %d, id %08x',
-                                        *key)
-                            if not self.uubnums and not self.records:
-                                self.done.set()
+                            self._done(key, logger)
+                        elif key in self.nacks:
+                            self.nacks[key][0] = datetime.now().timestamp()
                     except ValueError as e:
                         logger.error('addChunk error %s, ' +
                                      'UUB %d, port %d, id %08x',
                                      e.__str__(), *key)
                 else:
                     cid, start, end = NetscopeData.chunkHead(data)
+                    if uubnum in self.uubnums and key not in self.nacks:
+                        # header lost, ask for whole event
+                        self.nacks[key] = [datetime.now().timestamp(), 0]
                     logger.debug('orphan chunk for UUB %d, port %d,' +
                                  ' id %08x [%04x:%04x]',
                                  key[0], key[1], cid, start, end)
         logger.info("Leaving run()")
         self.sock.close()
+        self.nacksock.close()
+
+    def _run_native(self, logger):
+        """run() by NetscopeRecv: records reassembled in C, NACKs of
+stalled ones sent each SLEEPTIME"""
+        libpath = None if self.native is True else self.native
+        recv = NetscopeRecv(self.port, self.laddr, self.mcast, self.RCVBUF,
+                            libpath=libpath)
+        self.nacksock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.nacksock.setblocking(False)
+        logger.info("Listening on %s:%d by %s", self.mcast or self.laddr,
+                    self.port, recv.libpath)
+        nacks = {}  # key: NACKs sent
+        checktime = 0  # timestamp of the last stalled and credit check
+        while not self.stop.is_set():
+            if self.clear:
+                recv.clear()
+                nacks = {}
+                self.averages = {}
+                self.clear = False
+                self.cleared.set()
+            ev = recv.next(self.SLEEPTIME)
+            # each SLEEPTIME, also while events keep completing
+            now = datetime.now().timestamp()
+            if now - checktime >= self.SLEEPTIME:
+                checktime = now
+                for sev in recv.stalled(self.NACKTIME):
+                    key = (ip2uubnum(recv.addr(sev)), sev.contents.port,
+                           sev.contents.sh.id)
+                    if key[0] not in self.uubnums or \
+                       nacks.get(key, 0) >= self.NACKMAX:
+                        continue
+                    ranges = []
+                    for r in recv.missing(sev, self.NACKRANGES):
+                        ranges.extend(r)
+                    self._sendnack(key, ranges, logger)
+                    nacks[key] = nacks.get(key, 0) + 1
+                self._discardreplies()
+                self._credit(logger)
+            if ev is None:
+                continue
+            uubnum = ip2uubnum(recv.addr(ev))
+            if ev.contents.kind == NetscopeRecv.NSR_STATS:
+                data = bytes(recv.payload(ev))
+                recv.release(ev)
+                if unpack('<L', data[:4])[0] == NetscopeRates.MAGIC:
+                    self._rates(data, uubnum, logger)
+                    continue
+                try:
+                    stats = NetscopeStats(data, uubnum)
+                except struct_error:
+                    logger.error('stats length error (%d) from UUB %d',
+                                 len(data), uubnum)
+                    continue
+                logger.info('stats UUB %d: %s', uubnum, stats)
+                if self.q_stats is not None:
+                    self.q_stats.put(stats)
+                continue
+            key = (uubnum, ev.contents.port, ev.contents.sh.id)
+            nacks.pop(key, None)
+            if uubnum not in self.uubnums:
+                logger.debug('unsolicited record (UUB %d, port %d, id %08x)',
+                             *key)
+                recv.release(ev)
+                continue
+            self._discard(key)
+            nd = NetscopeData.fromNative(recv, ev, uubnum, self.details)
+            if recv.nout > recv.nslot // 2:
+                nd.release()  # copy, consumer too slow to keep slots
+            self._putdata(nd, key, logger)
+            logger.info('done record UUB %d, port %d, id %08x', *key)
+            self._credit(logger)
+            if not self.uubnums:
+                self.done.set()
+        logger.info("Leaving run()")
+        recv.close()
+        self.nacksock.close()
 
 
 class Coverage(object):
@@ -661,6 +925,12 @@ Return False if overlapping or outside, True otherwise."""
             self.ends.pop(pos-1)
         return True
 
+    def missing(self):
+        """Return list of (start, end) not covered yet."""
+        return [(start, end) for start, end in
+                zip([0] + self.ends, self.starts + [self.size])
+                if start < end]
+
     def isCovered(self):
         """Return True if (0, MAX) completely covered."""
         return len(self.starts) == 1 and \
@@ -675,14 +945,32 @@ Return False if overlapping or outside, True otherwise."""
 class NetscopeData(object):
     """ Data received from netscope """
     HEADER = ('id', 'shwr_buf_status', 'shwr_buf_start', 'shwr_buf_trig_id',
-              'ttag_shwr_seconds', 'ttag_shwr_nanosec', 'rd')
+              'ttag_shwr_seconds', 'ttag_shwr_nanosec', 'rd',
+              'format', 'size')
+    NLEGACY = 7         # number of fields in header without format and size
     NPOINT = 2048
     RAWDATASIZE = 4 * 5 * NPOINT
     FRAGHEADLEN = 8     # LHH: id, start, end
+    # payload formats, see SHWR_FMT_* in netscope.c
+    FMT_RAW = 0
+    FMT_PACKED12 = 1
+    FMT_DELTA = 2
+    FMT_MUON = 3
+    FMT_FEATURE = 4
+    FMT_AVERAGE = 5
+    FEATURE = ('mean', 'rms', 'peak', 'peakpos')  # struct feature
+    DELTA_BLOCK = 64
+    MUON_ID = 0x40000000  # flag in id of muon events
+    AVERAGE_ID = 0x20000000  # flag in id of averaged block events
+    ID_MASK = 0x1FFFFFFF  # event counter in id (ID_MASK in read_evt.h)
+    NADC = 5            # averaged block events, one per ADC
 
     def __init__(self, header, uubnum, details=None):
         """Constructor.
 header - data as in `struct shwr_header'"""
+        if len(header) == 4 * NetscopeData.NLEGACY:  # netscope before format
+            header += pack('<LL', NetscopeData.FMT_RAW,
+                           NetscopeData.RAWDATASIZE)
         headerdata = unpack('<%dL' % len(NetscopeData.HEADER), header)
         headerdict = dict(zip(NetscopeData.HEADER, headerdata))
         self.__dict__.update(headerdict)
@@ -690,9 +978,39 @@ header - data as in `struct shwr_header'"""
         self.uubnum = uubnum
         self.details = details if details is not None else {
             'timestampmicro': datetime.now()}
-        self.rawdata = bytearray(NetscopeData.RAWDATASIZE)
+        self.rawdata = bytearray(self.size)
         self.yall = None
-        self.cover = Coverage(NetscopeData.RAWDATASIZE)
+        self.cover = Coverage(self.size)
+        self.native = None  # (NetscopeRecv, event) if from fromNative()
+
+    @classmethod
+    def fromNative(cls, recv, ev, uubnum, details=None):
+        """Constructor from NetscopeRecv event ev, complete already;
+rawdata is a view of its slot, kept until release()"""
+        self = cls.__new__(cls)
+        sh = ev.contents.sh
+        self.__dict__.update({key: getattr(sh, key) for key in cls.HEADER})
+        self.uubnum = uubnum
+        self.details = details if details is not None else {
+            'timestampmicro': datetime.now()}
+        self.rawdata = recv.payload(ev)
+        self.yall = None
+        self.cover = None
+        self.native = (recv, ev)
+        return self
+
+    def release(self):
+        """Return the slot of native event to NetscopeRecv, rawdata copied
+if still needed"""
+        if self.native is None:
+            return
+        recv, ev = self.native
+        self.native = None
+        self.rawdata = bytes(self.rawdata)
+        recv.release(ev)
+
+    def __del__(self):
+        self.release()
 
     @staticmethod
     def chunkHead(chunk):
@@ -700,17 +1018,23 @@ header - data as in `struct shwr_header'"""
         return unpack('<LHH', chunk[:NetscopeData.FRAGHEADLEN])
 
     def addChunk(self, chunk):
-        """Add a chunk into data. Return True if data complete."""
+        """Add a chunk into data, parts already received (resent chunks)
+skipped. Return True if data complete."""
         # fragment header
         cid, start, end = NetscopeData.chunkHead(chunk)
         if len(chunk) - NetscopeData.FRAGHEADLEN != end - start:
             raise ValueError("Wrong start/end versus chunk length")
         if cid != self.id:
             raise ValueError("Wrong id %d (%d expected)" % (cid, self.id))
-        if not self.cover.insert(start, end):
-            raise ValueError("Incompatible chunk (%d, %d), already covered %s"
-                             % (start, end, self.cover.__str__()))
-        self.rawdata[start:end] = bytearray(chunk[NetscopeData.FRAGHEADLEN:])
+        if not 0 <= start < end <= self.size:
+            raise ValueError("Chunk (%d, %d) outside data of size %d"
+                             % (start, end, self.size))
+        payload = chunk[NetscopeData.FRAGHEADLEN:]
+        for mstart, mend in self.cover.missing():
+            a, b = max(start, mstart), min(end, mend)
+            if a < b:
+                self.cover.insert(a, b)
+                self.rawdata[a:b] = payload[a - start:b - start]
         return self.cover.isCovered()
 
     def header(self):
@@ -721,10 +1045,95 @@ header - data as in `struct shwr_header'"""
         #     d.update(self.details)
         return d
 
+    def isMuon(self):
+        """Return True if data are muon buffers"""
+        return self.format == NetscopeData.FMT_MUON
+
+    def isFeature(self):
+        """Return True if data are features instead of trace"""
+        return self.format == NetscopeData.FMT_FEATURE
+
+    def isAverage(self):
+        """Return True if data are sums over a block of traces"""
+        return self.format == NetscopeData.FMT_AVERAGE
+
+    @staticmethod
+    def averagePart(nid):
+        """Return (block, adc) of averaged block event id nid, None if
+it is another one"""
+        if nid & (NetscopeData.MUON_ID | NetscopeData.AVERAGE_ID) \
+           != NetscopeData.AVERAGE_ID:
+            return None
+        return divmod(nid & NetscopeData.ID_MASK, NetscopeData.NADC)
+
+    @classmethod
+    def mergeAverage(cls, parts):
+        """Return one record from averaged block events of all ADCs,
+ordered by adc; header of the first one"""
+        self = cls.__new__(cls)
+        self.__dict__.update(parts[0].__dict__)
+        self.rawdata = b''.join([bytes(part.rawdata) for part in parts])
+        self.size = len(self.rawdata)
+        self.yall = None
+        self.cover = None
+        self.native = None
+        return self
+
+    def average(self):
+        """Return sums of merged averaged block as dictionary: n (number of
+traces), mean and var (per sample variance) 2048x10 numpy arrays"""
+        npoint = self.NPOINT
+        partsize = 4 + 16 * npoint
+        mean = np.empty([npoint, 10])
+        var = np.zeros([npoint, 10])
+        for adc in range(self.NADC):
+            n, = unpack('<H', self.rawdata[adc*partsize:adc*partsize+2])
+            a = np.frombuffer(self.rawdata, dtype='<u4', count=4 * npoint,
+                              offset=adc*partsize + 4).reshape(
+                                  2, 2, npoint).astype(float)
+            mean[:, 2*adc:2*adc+2] = (a[0] / n).T
+            if n > 1:
+                var[:, 2*adc:2*adc+2] = ((a[1] - a[0]**2 / n) / (n-1)).T
+        return {'n': n, 'mean': mean, 'var': var}
+
+    def features(self):
+        """Return features as dictionary: pedstart, pedend (pedestal window)
+and mean, rms, peak, peakpos numpy arrays of 10 channels"""
+        pedstart, pedend = unpack('<HH', self.rawdata[:4])
+        f = np.frombuffer(self.rawdata, offset=4, dtype=np.dtype(
+            [('mean', '<f4'), ('rms', '<f4'),
+             ('peak', '<u2'), ('peakpos', '<u2')]))
+        d = {key: f[key].astype(float) for key in self.FEATURE}
+        d.update(pedstart=pedstart, pedend=pedend)
+        return d
+
     def convertData(self):
-        """Convert raw data to numpy 2048x10 array"""
+        """Convert raw data to numpy 2048x10 array
+muon data: 2xN array of raw MUON0/MUON1 words
+features: None (see features())
+averaged block (merged): mean traces (see average())"""
         if self.yall is not None:
             return self.yall
+        if self.format == NetscopeData.FMT_FEATURE:
+            return None
+        if self.format == NetscopeData.FMT_AVERAGE:
+            self.yall = self.average()['mean']
+            return self.yall
+        if self.format == NetscopeData.FMT_MUON:
+            self.yall = np.frombuffer(self.rawdata, dtype='<u4').reshape(
+                2, -1)
+            return self.yall
+        if self.native is not None:
+            y = self.native[0].decode(self.native[1])
+            if y is not None:
+                self.yall = y.T.astype(float)
+                return self.yall
+        if self.format == NetscopeData.FMT_PACKED12:
+            self.yall = self._convertPacked12()
+            return self.yall
+        if self.format == NetscopeData.FMT_DELTA:
+            self.yall = self._convertDelta()
+            return self.yall
         yall = np.zeros([self.NPOINT, 10], dtype=float)
         start = self.shwr_buf_start
         for i in range(self.NPOINT):
@@ -737,12 +1146,250 @@ header - data as in `struct shwr_header'"""
         self.yall = yall
         return yall
 
+    def _convertPacked12(self):
+        """Convert packed 12-bit data (already rotated) to 2048x10 array"""
+        b = np.frombuffer(self.rawdata, dtype=np.uint8).reshape(
+            10, self.NPOINT // 2, 3).astype(np.uint16)
+        y = np.empty([10, self.NPOINT], dtype=np.uint16)
+        y[:, 0::2] = b[:, :, 0] | ((b[:, :, 1] & 0xF) << 8)
+        y[:, 1::2] = (b[:, :, 1] >> 4) | (b[:, :, 2] << 4)
+        return y.T.astype(float)
+
+    def _convertDelta(self):
+        """Convert delta + bit packed data (already rotated) to 2048x10 array
+Each channel is NPOINT/DELTA_BLOCK blocks of zigzag coded differences,
+block = bit width w and DELTA_BLOCK w-bit values LSB first."""
+        nblk = self.NPOINT // self.DELTA_BLOCK
+        z = np.empty([10, self.NPOINT], dtype=np.int32)
+        pos = 0
+        for ch in range(10):
+            for blk in range(nblk):
+                w = self.rawdata[pos]
+                n = self.DELTA_BLOCK * w // 8
+                v = int.from_bytes(self.rawdata[pos+1:pos+1+n], 'little')
+                pos += 1 + n
+                mask = (1 << w) - 1
+                z[ch, blk*self.DELTA_BLOCK:(blk+1)*self.DELTA_BLOCK] = [
+                    (v >> (k*w)) & mask for k in range(self.DELTA_BLOCK)]
+        d = (z >> 1) ^ -(z & 1)
+        return np.cumsum(d, axis=1).T.astype(float)
+
     def __str__(self):
         return ("NetscopeData(uubnum=%04d, cid=0x%08x, details=%s, " +
                 "coverage=%s)") % (self.uubnum, self.id, repr(self.details),
                                    self.cover.__str__())
 
 
+class NetscopeStats(object):
+    """Stats datagram from netscope (see struct stats in netscope.c)"""
+    MAGIC = 0xFFFF5354
+    COUNTERS = ('interval', 'events', 'drops', 'fullbuf', 'ringfull',
+                'readerr', 'nacks', 'muons', 'nocredit', 'creditdrops',
+                'senderr')
+    NBUCKET = 24
+    # histogram name, log2 (True) or linear
+    HISTS = (('latency', True), ('latency0', True), ('latency1', True),
+             ('copy', True), ('send', True), ('nfull', False),
+             ('ring', False))
+
+    def __init__(self, data, uubnum):
+        nwords = 1 + len(self.COUNTERS) + len(self.HISTS) * self.NBUCKET
+        words = unpack('<%dL' % nwords, data)
+        self.uubnum = uubnum
+        self.timestamp = datetime.now()
+        self.__dict__.update(zip(self.COUNTERS, words[1:]))
+        pos = 1 + len(self.COUNTERS)
+        self.hists = {}
+        for name, log2 in self.HISTS:
+            self.hists[name] = words[pos:pos+self.NBUCKET]
+            pos += self.NBUCKET
+
+    def quantile(self, name, q):
+        """Return upper bound of bucket containing quantile q of histogram
+name, None if empty"""
+        hist = self.hists[name]
+        total = sum(hist)
+        if not total:
+            return None
+        log2 = dict(self.HISTS)[name]
+        acc = 0
+        for b, n in enumerate(hist):
+            acc += n
+            if acc >= q * total:
+                break
+        if not log2:
+            return b
+        return (1 << b) - 1
+
+    def __str__(self):
+        res = ', '.join(['%s %d' % (key, self.__dict__[key])
+                         for key in self.COUNTERS])
+        for name in ('latency', 'copy', 'send', 'nfull'):
+            if sum(self.hists[name]):
+                res += ', %s p50 <= %d, p99 <= %d' % (
+                    name, self.quantile(name, 0.5),
+                    self.quantile(name, 0.99))
+        return res
+
+
+
+class NetscopeRates(object):
+    """Rates datagram from netscope (see struct rates in netscope.c):
+trigger rate and scaler registers as read, sampled each netscope -R or
+NetscopeCtrl.rates() period"""
+    MAGIC = 0xFFFF5254
+    FIELDS = ('seconds', 'interval', 'trig_rates', 'delayed_rates',
+              'scaler_a', 'scaler_b', 'scaler_c')
+
+    def __init__(self, data, uubnum):
+        words = unpack('<%dL' % (1 + len(self.FIELDS)), data)
+        self.uubnum = uubnum
+        self.timestamp = datetime.now()
+        self.__dict__.update(zip(self.FIELDS, words[1:]))
+
+    def __str__(self):
+        return ', '.join(['%s %d' % (key, self.__dict__[key])
+                          for key in self.FIELDS])
+
+
+class NetscopeRecv(object):
+    """ctypes wrapper of libnsrecv.so (uub-sdk/nsrecv): netscope datagrams
+received by recvmmsg and reassembled in C, completed events handed out
+in place until release()"""
+    LIBPATH = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           'uub-sdk', 'nsrecv', 'build', 'libnsrecv.so')
+    NSR_NSLOT = 256  # default nslot
+    NSR_EVENT = 0
+    NSR_STATS = 1
+    NCH = 10
+
+    class ShwrHeader(ctypes.Structure):
+        _fields_ = [(key, ctypes.c_uint32) for key in NetscopeData.HEADER]
+
+    class Event(ctypes.Structure):
+        pass
+
+    Event._fields_ = [('kind', ctypes.c_int),
+                      ('addr', ctypes.c_uint32),
+                      ('port', ctypes.c_uint32),
+                      ('sh', ShwrHeader),
+                      ('data', ctypes.POINTER(ctypes.c_uint8)),
+                      ('len', ctypes.c_uint32),
+                      ('tfirst', ctypes.c_longlong),
+                      ('tlast', ctypes.c_longlong)]
+
+    class Stats(ctypes.Structure):
+        _fields_ = [(key, ctypes.c_uint64) for key in (
+            'datagrams', 'bytes', 'events', 'stats', 'evicted', 'nofree',
+            'duplicates', 'invalid')]
+
+    def __init__(self, port, laddr='', mcast=None, rcvbuf=0, nslot=0,
+                 libpath=None):
+        self.libpath = libpath or self.LIBPATH
+        lib = ctypes.CDLL(self.libpath)
+        PEvent = ctypes.POINTER(self.Event)
+        lib.nsr_open.restype = ctypes.c_void_p
+        lib.nsr_open.argtypes = (ctypes.c_char_p, ctypes.c_uint,
+                                 ctypes.c_char_p, ctypes.c_int, ctypes.c_uint)
+        lib.nsr_close.argtypes = (ctypes.c_void_p, )
+        lib.nsr_next.restype = PEvent
+        lib.nsr_next.argtypes = (ctypes.c_void_p, ctypes.c_int)
+        lib.nsr_release.argtypes = (ctypes.c_void_p, PEvent)
+        lib.nsr_clear.argtypes = (ctypes.c_void_p, )
+        lib.nsr_stalled.argtypes = (ctypes.c_void_p, ctypes.c_longlong,
+                                    ctypes.POINTER(PEvent), ctypes.c_int)
+        lib.nsr_missing.argtypes = (PEvent, ctypes.POINTER(ctypes.c_uint32),
+                                    ctypes.c_int)
+        lib.nsr_decode.argtypes = (PEvent, ctypes.c_void_p)
+        lib.nsr_getstats.argtypes = (ctypes.c_void_p,
+                                     ctypes.POINTER(self.Stats))
+        self.lib = lib
+        self.r = lib.nsr_open(laddr.encode() if laddr else None, port,
+                              mcast.encode() if mcast else None,
+                              rcvbuf, nslot)
+        if not self.r:
+            raise OSError('nsr_open failed on port %d' % port)
+        self.nslot = nslot or self.NSR_NSLOT
+        self.lock = threading.Lock()
+        self.nout = 0      # events handed out and not released
+        self.closing = False
+
+    def next(self, timeout=None):
+        """Return the next completed event or stats (pointer to Event),
+waiting up to timeout s (None forever), None on timeout"""
+        ms = -1 if timeout is None else int(timeout * 1000)
+        ev = self.lib.nsr_next(self.r, ms)
+        if not ev:
+            return None
+        with self.lock:
+            self.nout += 1
+        return ev
+
+    def release(self, ev):
+        """Return ev's slot; close deferred until the last one"""
+        self.lib.nsr_release(self.r, ev)
+        with self.lock:
+            self.nout -= 1
+            close = self.closing and self.nout == 0
+        if close:
+            self._close()
+
+    @staticmethod
+    def addr(ev):
+        """Sender IP address of ev as string"""
+        return socket.inet_ntoa(pack('>L', ev.contents.addr))
+
+    @staticmethod
+    def payload(ev):
+        """Payload of ev as numpy uint8 array, without copy"""
+        n = ev.contents.len
+        if not n:
+            return np.zeros(0, dtype=np.uint8)
+        return np.ctypeslib.as_array(ev.contents.data, shape=(n, ))
+
+    def decode(self, ev):
+        """Return traces of ev as numpy uint16 array 10x2048 (HG0, LG0, ...)
+rotated by shwr_buf_start, None if ev has no traces"""
+        y = np.empty([self.NCH, NetscopeData.NPOINT], dtype=np.uint16)
+        if self.lib.nsr_decode(ev, y.ctypes.data) < 0:
+            return None
+        return y
+
+    def stalled(self, age, n=64):
+        """List of up to n incomplete events without datagram for age s"""
+        evs = (ctypes.POINTER(self.Event) * n)()
+        k = self.lib.nsr_stalled(self.r, int(age * 1e6), evs, n)
+        return evs[:k]
+
+    def missing(self, ev, n=16):
+        """List of up to n missing (start, end) of ev, [] for whole event"""
+        ranges = (ctypes.c_uint32 * (2 * n))()
+        k = self.lib.nsr_missing(ev, ranges, n)
+        return [(ranges[2*i], ranges[2*i+1]) for i in range(k)]
+
+    def clear(self):
+        """Drop incomplete and not yet handed out events"""
+        self.lib.nsr_clear(self.r)
+
+    def stats(self):
+        """Counters since open as dictionary"""
+        st = self.Stats()
+        self.lib.nsr_getstats(self.r, ctypes.byref(st))
+        return {key: getattr(st, key) for key, _ in st._fields_}
+
+    def close(self):
+        with self.lock:
+            self.closing = True
+            close = self.nout == 0
+        if close:
+            self._close()
+
+    def _close(self):
+        if self.r:
+            self.lib.nsr_close(self.r)
+            self.r = None
+
+
 class UUBtelnet(threading.Thread):
     """Class making telnet to UUBs and run netscope program"""
 
@@ -973,6 +1620,22 @@ def ADCtup2c(tup):
     return chr(0x40 + on + (adc << 2) + chsel)
 
 
+
+def loadTraceDump(fn):
+    """Load binary trace dump of adc_check_ramp -D (see struct dump_header)
+Return (header dict, numpy uint16 array nsamples x nch as yall)"""
+    DUMP_MAGIC = 0x50444341
+    FIELDS = ('magic', 'version', 'hdrsize', 'nch', 'nsamples',
+              'id', 'shwr_buf_status', 'shwr_buf_start', 'shwr_buf_trig_id',
+              'ttag_shwr_seconds', 'ttag_shwr_nanosec', 'rd')
+    with open(fn, 'rb') as f:
+        header = dict(zip(FIELDS, unpack('<%dL' % len(FIELDS),
+                                         f.read(4 * len(FIELDS)))))
+    if header['magic'] != DUMP_MAGIC or header['version'] != 1:
+        raise ValueError('%s is not a trace dump version 1' % fn)
+    traces = np.fromfile(fn, dtype='<u2', offset=header['hdrsize'])
+    return header, traces.reshape(header['nch'], header['nsamples']).T
+
 class ADCramp(object):
     """Switch ADC to/from ramp test mode"""
     MSGLEN = 18   # length of UDP payload (minimal without padding)
@@ -1031,3 +1694,232 @@ If OK, return True, else return False"""
     def kill(self):
         """Kill adcramp deamon on UUB"""
         self._send_recv('!')
+
+
+class NetscopeCtrl(object):
+    """Commands to netscope control port (see CTRL_* in netscope.c)"""
+    CTRL_STOP = 1
+    CTRL_TRIGMASK = 2
+    CTRL_SBTRIG = 3
+    CTRL_COMPATSB = 4
+    CTRL_DEST = 5
+    CTRL_FRAGSIZE = 6
+    CTRL_NACK = 7
+    CTRL_MUONMASK = 8
+    CTRL_MUONTRIG = 9
+    CTRL_ADDDEST = 10
+    CTRL_DELDEST = 11
+    CTRL_RATES = 12
+    CTRL_SCALER = 13
+    CTRL_AVERAGE = 14
+    CTRL_CREDIT = 15
+    CREDIT_NOLIMIT = 0xFFFFFFFF
+    CREDIT_HOLD = 0
+    CREDIT_DROP = 1
+    CTRL_REPLY = 0x80000000
+    CTRL_OK = 0
+
+    def __init__(self, uubnum):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.settimeout(0.01)
+        self.addr = (uubnum2ip(uubnum), CTRLPORT)
+        self.logger = logging.getLogger('NetscopeCtrl %04d' % uubnum)
+
+    def _send_recv(self, cmd, *args):
+        """Send command with arguments, receive reply and check it.
+If OK, return tuple of values in reply, else return None"""
+        msg = pack('<%dL' % (1 + len(args)), cmd, *args)
+        self.logger.debug('sending cmd %d %s', cmd, repr(args))
+        self.sock.sendto(msg, self.addr)
+        try:
+            resp, addr = self.sock.recvfrom(1500)
+            rcmd, status = unpack('<LL', resp[:8])
+            values = unpack('<%dL' % (len(resp)//4 - 2), resp[8:])
+        except socket.timeout:
+            self.logger.info('timeout')
+            return None
+        except struct_error:
+            self.logger.info('short reply %s', repr(resp))
+            return None
+        if rcmd != cmd | self.CTRL_REPLY or status != self.CTRL_OK:
+            self.logger.info('Unexpected reply %08X %d', rcmd, status)
+            return None
+        return values
+
+    def stop(self):
+        """Stop netscope acquisition"""
+        return self._send_recv(self.CTRL_STOP) is not None
+
+    def trigMask(self, mask):
+        """Set SHWR_BUF_TRIG_MASK register"""
+        return self._send_recv(self.CTRL_TRIGMASK, mask) is not None
+
+    def sbTrig(self, thr0, thr1, thr2, ssd, enab):
+        """Set full bandwidth single bin trigger"""
+        return self._send_recv(self.CTRL_SBTRIG,
+                               thr0, thr1, thr2, ssd, enab) is not None
+
+    def compatSbTrig(self, thr0, thr1, thr2, enab):
+        """Set compatibility single bin trigger"""
+        return self._send_recv(self.CTRL_COMPATSB,
+                               thr0, thr1, thr2, enab) is not None
+
+    def muonMask(self, mask):
+        """Set MUON_BUF_TRIG_MASK register"""
+        return self._send_recv(self.CTRL_MUONMASK, mask) is not None
+
+    def muonTrig(self, n, thr0, thr1, thr2, ssd, enab):
+        """Set muon trigger n (1 or 2)"""
+        return self._send_recv(self.CTRL_MUONTRIG, n,
+                               thr0, thr1, thr2, ssd, enab) is not None
+
+    def dest(self, ip=LADDR, port=DATAPORT):
+        """Set destination of netscope data, the only one"""
+        addr = unpack('<L', socket.inet_aton(ip))[0]
+        return self._send_recv(self.CTRL_DEST, addr, port) is not None
+
+    def addDest(self, ip, port=DATAPORT):
+        """Add destination (unicast or multicast group) of netscope data"""
+        addr = unpack('<L', socket.inet_aton(ip))[0]
+        return self._send_recv(self.CTRL_ADDDEST, addr, port) is not None
+
+    def delDest(self, ip, port=DATAPORT):
+        """Remove destination of netscope data"""
+        addr = unpack('<L', socket.inet_aton(ip))[0]
+        return self._send_recv(self.CTRL_DELDEST, addr, port) is not None
+
+    def fragsize(self, size=9000):
+        """Propose max. datagram size the receiver accepts (UUBlisten
+PACKETSIZE), netscope may lower it to fit its MTU.
+Return datagram size used or None on error"""
+        values = self._send_recv(self.CTRL_FRAGSIZE, size)
+        return values[0] if values else None
+
+    def rates(self, period):
+        """Send rates datagram (NetscopeRates) each period ms, 0 stops it.
+Return period used or None on error"""
+        values = self._send_recv(self.CTRL_RATES, period)
+        return values[0] if values else None
+
+    def scaler(self, n, thr0, thr1, thr2, enab):
+        """Set compatibility scaler n (0 - 2: A - C)"""
+        return self._send_recv(self.CTRL_SCALER, n,
+                               thr0, thr1, thr2, enab) is not None
+
+    def average(self, n, k=0):
+        """Send sums of blocks of n (up to 256) traces instead of them,
+each k-th event as well (0 none); n = 0 stops it"""
+        return self._send_recv(self.CTRL_AVERAGE, n, k) is not None
+
+    def credit(self, events=CREDIT_NOLIMIT, nbytes=CREDIT_NOLIMIT, drop=False):
+        """Flow control: set credit of events and bytes netscope may send
+(CREDIT_NOLIMIT: not limited, both: flow control off); out of credit it
+holds shower buffers, pausing triggers, or drops events if drop"""
+        policy = self.CREDIT_DROP if drop else self.CREDIT_HOLD
+        return self._send_recv(self.CTRL_CREDIT,
+                               events, nbytes, policy) is not None
+
+
+class UUBagent(object):
+    """Commands to uubagent on UUB (see AGENT_* in uubagent.c)
+ADC, ramp check and jitter cleaner operations without starting
+a program by telnet for each"""
+    AGENT_PING = 1
+    AGENT_ADCINIT = 2
+    AGENT_RAMP = 3
+    AGENT_RAMPCHECK = 4
+    AGENT_JCINIT = 5
+    AGENT_JCVERIFY = 6
+    AGENT_ACQSTART = 7
+    AGENT_ACQSTOP = 8
+    AGENT_QUIT = 9
+    AGENT_REPLY = 0x80000000
+    AGENT_OK = 0
+    ADC_ALL = 0x1F
+    TIMEOUT = 0.1        # default reply timeout
+    SLOWTIMEOUT = 5.0    # ramp check, jitter cleaner, acquisition stop
+
+    def __init__(self, uubnum):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.addr = (uubnum2ip(uubnum), AGENTPORT)
+        self.logger = logging.getLogger('UUBagent %04d' % uubnum)
+
+    def _send_recv(self, cmd, *args, raw=b'', timeout=TIMEOUT):
+        """Send command with arguments (and raw bytes), receive reply
+and check it.  If OK, return tuple of values in reply, else return None"""
+        msg = pack('<%dL' % (1 + len(args)), cmd, *args) + raw
+        self.logger.debug('sending cmd %d %s', cmd, repr(args))
+        self.sock.settimeout(timeout)
+        self.sock.sendto(msg, self.addr)
+        try:
+            while True:
+                resp, addr = self.sock.recvfrom(1500)
+                rcmd, status = unpack('<LL', resp[:8])
+                if rcmd == cmd | self.AGENT_REPLY:
+                    break
+                self.logger.debug('stale reply %08X dropped', rcmd)
+            values = unpack('<%dL' % (len(resp)//4 - 2), resp[8:])
+        except socket.timeout:
+            self.logger.info('timeout')
+            return None
+        except struct_error:
+            self.logger.info('short reply %s', repr(resp))
+            return None
+        if status != self.AGENT_OK:
+            self.logger.info('cmd %d failed, status %d', cmd, status)
+            return None
+        return values
+
+    def ping(self):
+        """Return (protocol version, netscope pid or 0) or None"""
+        return self._send_recv(self.AGENT_PING)
+
+    def adcinit(self, adcmask=ADC_ALL):
+        """Initialize ADCs, return mask of ADCs with registers not read back
+as written or None on error"""
+        values = self._send_recv(self.AGENT_ADCINIT, adcmask)
+        return values[0] if values else None
+
+    def ramp(self, on, adcmask=ADC_ALL, chans=3):
+        """Switch ADCs to (on True) or from ramp test mode"""
+        return self._send_recv(self.AGENT_RAMP, 1 if on else 0,
+                               adcmask, chans) is not None
+
+    def rampcheck(self, nshots=1):
+        """Check ADC ramps in nshots (up to 1000) traces as adc_check_ramp
+Return (mask of failing ADCs, list of bad shots per channel) or None"""
+        values = self._send_recv(self.AGENT_RAMPCHECK, nshots,
+                                 timeout=self.SLOWTIMEOUT)
+        return (values[0], list(values[1:])) if values else None
+
+    def jcinit(self, verify=False):
+        """Initialize jitter cleaner, return jitter_cleaner exit code"""
+        values = self._send_recv(self.AGENT_JCINIT, 1 if verify else 0,
+                                 timeout=self.SLOWTIMEOUT)
+        return values[0] if values else None
+
+    def jcverify(self):
+        """Verify jitter cleaner registers, return jitter_cleaner exit code"""
+        values = self._send_recv(self.AGENT_JCVERIFY,
+                                 timeout=self.SLOWTIMEOUT)
+        return values[0] if values else None
+
+    def acqstart(self, *args):
+        """Start netscope with args (str), return its pid or None"""
+        raw = b''.join([bytes(arg, 'ascii') + b'\0' for arg in args])
+        raw += bytes(-len(raw) % 4)
+        values = self._send_recv(self.AGENT_ACQSTART, raw=raw)
+        return values[0] if values else None
+
+    def acqstop(self):
+        """Stop netscope, return its exit code (-1 if killed) or None"""
+        values = self._send_recv(self.AGENT_ACQSTOP,
+                                 timeout=self.SLOWTIMEOUT)
+        if values is None:
+            return None
+        return values[0] if values[0] < 0x80000000 else values[0] - (1 << 32)
+
+    def quit(self):
+        """Stop acquisition and exit uubagent"""
+        return self._send_recv(self.AGENT_QUIT,
+                               timeout=self.SLOWTIMEOUT) is not None
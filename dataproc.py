@@ -269,6 +269,10 @@ dp_ctx - context with configuration (dict)
                 item['chs'] = chs[uubnum]
         item['uubnum'] = uubnum
         item['yall'] = nd.convertData()
+        if nd.isFeature():
+            item['features'] = nd.features()
+        if nd.isAverage():
+            item['average'] = nd.average()
         label = item2label(item)
         logger.debug('conversion UUB %04d, id %08x done, processing %s',
                      nd.uubnum, nd.id, label)
@@ -446,9 +450,18 @@ q_resp - a logger queue
             return
         self.logger.debug('Processing %s', item2label(item))
         chs = item.get('chs', self.CHS)
-        array = item['yall'][self.BINSTART:self.BINEND, chs]
-        mean = array.mean(axis=0)
-        stdev = array.std(axis=0, ddof=1)
+        if item['yall'] is None:  # features computed by netscope
+            mean = item['features']['mean'][chs]
+            stdev = item['features']['rms'][chs]
+        elif 'average' in item:  # noise as per sample rms over the block
+            avg = item['average']
+            mean = avg['mean'][self.BINSTART:self.BINEND, chs].mean(axis=0)
+            stdev = np.sqrt(
+                avg['var'][self.BINSTART:self.BINEND, chs].mean(axis=0))
+        else:
+            array = item['yall'][self.BINSTART:self.BINEND, chs]
+            mean = array.mean(axis=0)
+            stdev = array.std(axis=0, ddof=1)
         res = {'timestamp': item['timestamp']}
         itemr = {key: item[key]
                  for key in ('uubnum', 'functype', 'index')
@@ -491,8 +504,12 @@ kwargs: splitmode, voltage (fixed paramters)"""
         voltage = item.get('voltage', self.keys['voltage'])
         chs = [ch for ch in item.get('chs', self.chs)
                if not self.notcalc('P', ch+1, splitmode, voltage)]
-        yall = item['yall'][:, chs]
-        hsfres = self.hsf.fit(yall, HalfSineFitter.AMPLI)
+        if item['yall'] is None:  # features: peak above pedestal
+            f = item['features']
+            hsfres = {'ampli': f['peak'][chs] - f['mean'][chs]}
+        else:
+            yall = item['yall'][:, chs]
+            hsfres = self.hsf.fit(yall, HalfSineFitter.AMPLI)
         res = {'timestamp': item['timestamp']}
         itemr = {key: item[key]
                  for key in ('functype', 'uubnum', 'splitmode', 'voltage',
@@ -515,6 +532,8 @@ class DP_store:
         self.logger = logging.getLogger(logname)
 
     def calculate(self, item):
+        if item['yall'] is None:
+            return
         label = item2label(item)
         self.logger.debug('Processing %s', label)
         fn = '%s/dataall_%s.txt' % (self.datadir, label)
@@ -544,7 +563,7 @@ kwargs: freq, splitmode, voltage (fixed paramters)"""
                      if key in kwargs}
 
     def calculate(self, item):
-        if item.get('functype', None) != 'F':
+        if item.get('functype', None) != 'F' or item['yall'] is None:
             return
         self.logger.debug('Processing %s', item2label(item))
         splitmode = item.get('splitmode', self.keys['splitmode'])
@@ -585,7 +604,7 @@ invalid_chs - if not None, store there list of failed channels (-1)
         self.aramp = np.arange(2048, dtype='int16')
 
     def calculate(self, item):
-        if item.get('functype', None) != 'R':
+        if item.get('functype', None) != 'R' or item['yall'] is None:
             return
         self.logger.debug('Processing %s', item2label(item))
         itemr = {key: item[key] for key in ('uubnum', 'functype')}
@@ -16,14 +16,13 @@
 #include <getopt.h>
 #include <string.h>
 #include <arpa/inet.h>
-#include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <sys/types.h>
 #include <linux/types.h>
-#include <linux/spi/spidev.h>
+#include "adc_spi.h"
 
 #define CTRLPORT 8886   // The port for cmd and resp
 #define MSGLEN 18       // Length of UDP data (to avoid padding)
@@ -39,11 +38,6 @@
 #define RESP_BASE  0x20
 #define RESP_ERR   0x10
 
-#define ADDR_CHS   0x05
-#define ADDR_TEST  0x0D
-#define RAMPON     0x0F
-#define RAMPOFF    0x00
-
 /* global variables */
 char buf[MSGLEN];
 struct sockaddr src_addr;
@@ -60,94 +54,17 @@ static void pabort(const char *s) {
   abort();
 }
 
-int openspidev(int adc) {
-  int fd;
-  char filename[20];
-
-  snprintf(filename, 19, "/dev/spidev32766.%d", adc);
-  fd = open(filename, O_RDWR);
-  if (fd < 0)
-    pabort("can't open device");
-  return fd;
-}
-
-void spi_init(int adcfd) {
-  static uint8_t mode = 0;
-  static uint8_t bits = 8;
-  static uint32_t speed = 5000000;
-  
-  int ret;
-
-  // spi mode
-  ret = ioctl(adcfd, SPI_IOC_WR_MODE, &mode);
-  if (ret == -1)
-    pabort("can't set spi mode");
-  
-  ret = ioctl(adcfd, SPI_IOC_RD_MODE, &mode);
-  if (ret == -1)
-    pabort("can't get spi mode");
-  
-  // bits per word
-  ret = ioctl(adcfd, SPI_IOC_WR_BITS_PER_WORD, &bits);
-  if (ret == -1)
-    pabort("can't set bits per word");
-
-  ret = ioctl(adcfd, SPI_IOC_RD_BITS_PER_WORD, &bits);
-  if (ret == -1)
-    pabort("can't get bits per word");
-  
-  // max speed hz
-  ret = ioctl(adcfd, SPI_IOC_WR_MAX_SPEED_HZ, &speed);
-  if (ret == -1)
-    pabort("can't set max speed hz");
-
-  ret = ioctl(adcfd, SPI_IOC_RD_MAX_SPEED_HZ, &speed);
-  if (ret == -1)
-    pabort("can't get max speed hz");
-}
-
-int adc_read(int adcfd, int address) {
-  struct spi_ioc_transfer xfer[2];
-  unsigned char buf[32];
-  int status;
-
-  memset(xfer, 0, sizeof xfer);
-  memset(buf, 0, sizeof buf);
-
-  /* Read register 1 */
-  buf[0] = 0x80 | ((address>>8) & 0xff);
-  buf[1] = address & 0xff;
-
-  xfer[0].tx_buf = (unsigned long) buf;
-  xfer[0].len = 2;
-
-  xfer[1].rx_buf = (unsigned long) buf;
-  xfer[1].len = 1;
-
-  status = ioctl(adcfd, SPI_IOC_MESSAGE(2), xfer);
-  if (status < 0) {
-    perror("SPI_IOC_MESSAGE");
-    return (-1);
-  }
-
-  // printf("Address value : %03x %02x\n", address, buf[0]);
-  return ((int) buf[0]);
-}
-
-int adc_write(int adcfd, int address, int cmd) {
-  char cmdstr[3];
-
-  cmdstr[0] = (address>>8) & 0xff;
-  cmdstr[1] = address & 0xff;
-  cmdstr[2] = cmd;
-
-  if (write(adcfd, cmdstr, sizeof(cmdstr)) != sizeof(cmdstr)) {
-    pabort("adc_write");
-  }
-  return 1;
+/*
+ * spi_error handler: failed read is reported by adc_read() returning -1,
+ * other SPI errors abort
+ */
+static void spi_abort(int err, int fd, const char *msg) {
+  if(err == SPI_EREAD)
+    perror(msg);
+  else
+    pabort(msg);
 }
 
-
 /*
  * control socket: read cmds, write responses
  */
@@ -185,6 +102,7 @@ int main(int argc, char **argv) {
   //  fprintf(stderr, "main begin\n");
   sock = opencontrolsock();
   //  fprintf(stderr, "sock open\n");
+  spi_error = spi_abort;
   for( adc = 0; adc < NADC; adc++ ) {
     fd = openspidev(adc);
     spi_init(fd);
@@ -218,9 +136,8 @@ int main(int argc, char **argv) {
 	if((adc = (c & MASK_ADC) >> SH_ADC) >= NADC) {
 	  resp |= RESP_ERR;
 	  break; }
-	adc = adcfd[adc];
-	adc_write(adc, ADDR_CHS, c & MASK_CHS);
-	adc_write(adc, ADDR_TEST, (c & MASK_ON) ? RAMPON : RAMPOFF);
+	adc_testmode(adcfd[adc], c & MASK_CHS,
+		     (c & MASK_ON) ? ADC_TEST_RAMP : ADC_TEST_OFF);
 	resp ++; }
       else {  // invalid cmd
 	resp |= RESP_ERR;
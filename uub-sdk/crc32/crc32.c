@@ -1,55 +1,190 @@
 /*
- * Calculate CRC32 over a file and print the result as hex
- * CRC32 defined as in U-BOOT (using zlib implementation)
+ * Calculate CRC32 over files and print the result as hex
+ * CRC32 defined as in U-BOOT (zlib crc32(), reflected 0xEDB88320),
+ * computed here by slice-by-8 tables, no zlib needed
  * Petr Tobiska <tobiska@fzu.cz>
  * 2021-07-09
 
  source /opt/xilinx/SDK/2015.2/settings64.sh (replace with your path Xilinx SDK)
 
- prerequisities: build zlib (TODO: put it into Makefile)
-   wget https://zlib.net/zlib-1.2.11.tar.gz && tar zxf zlib-1.2.11.tar.gz
-   cd zlib-1.2.11
-   CC=arm-xilinx-linux-gnueabi-gcc ./configure --prefix=.
-   make
-   make DESTDIR=../zlib/ install
-   cd ..
-
- optional clean up: rm zlib-1.2.11.tar.gz && rm -rf zlib-1.2.11
- (not necessary after successful build of zlib; include/lib files are in crc32/zlib)
-
  build crc32 binary: make (from crc32 directory), result: build/crc32
+
+ usage: crc32 [-q] <file>[:<crc>] ...
+   one file without crc: print its crc as before
+   otherwise print "<crc>  <file>" per file, with OK or FAILED
+   for files given with expected crc (hex)
+   -q: print only errors and failed files
+   -T: self-check of slice-by-8 against bytewise CRC and exit
+   exit code: 0 all files read and matching, 1 usage,
+              2 some file cannot be read, 3 some crc differs
  */
 
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdlib.h>
 
-#include "zlib.h"
+#define BUFSIZE (256*1024)   /* read chunk if file cannot be mapped */
+#define POLY 0xEDB88320
+#define CHECK_CRC 0xCBF43926  /* crc of "123456789" */
+#define EXIT_USAGE 1
+#define EXIT_READ  2
+#define EXIT_CRC   3
 
-#define BUFSIZE 4096
+static uint32_t crc_table[8][256];
 unsigned char buf[BUFSIZE];
 
-int main(int argc, char **argv) {
-  int fd;
+/*
+ * crc_table[0]: bytewise table, crc_table[k]: crc of byte followed
+ * by k zero bytes
+ */
+void crc_init(void) {
+  uint32_t c;
+  int i, k;
+
+  for(i = 0; i < 256; i++) {
+    c = i;
+    for(k = 0; k < 8; k++)
+      c = (c & 1) ? (c >> 1) ^ POLY : c >> 1;
+    crc_table[0][i] = c;
+  }
+  for(i = 0; i < 256; i++)
+    for(k = 1; k < 8; k++)
+      crc_table[k][i] = (crc_table[k-1][i] >> 8)
+	^ crc_table[0][crc_table[k-1][i] & 0xff];
+}
+
+/*
+ * update crc (0 at start) by n bytes of p, as zlib crc32()
+ */
+uint32_t crc_update(uint32_t crc, const unsigned char *p, size_t n) {
+  crc = ~crc;
+  for(; n >= 8; n -= 8, p += 8) {
+    crc ^= p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+    crc = crc_table[7][crc & 0xff] ^ crc_table[6][(crc >> 8) & 0xff]
+      ^ crc_table[5][(crc >> 16) & 0xff] ^ crc_table[4][crc >> 24]
+      ^ crc_table[3][p[4]] ^ crc_table[2][p[5]]
+      ^ crc_table[1][p[6]] ^ crc_table[0][p[7]];
+  }
+  while(n--)
+    crc = (crc >> 8) ^ crc_table[0][(crc ^ *p++) & 0xff];
+  return ~crc;
+}
+
+/*
+ * compare slice-by-8 with bytewise update at all alignments and lengths
+ * return number of differences
+ */
+int crc_check(void) {
+  uint32_t a, b;
+  int i, off, len, nbad = 0;
+
+  if(crc_update(0, (const unsigned char *)"123456789", 9) != CHECK_CRC)
+    nbad++;
+  srand(1);
+  for(i = 0; i < 4096; i++)
+    buf[i] = rand();
+  for(off = 0; off < 8; off++)
+    for(len = 0; len < 100; len++) {
+      a = crc_update(0, buf + off, len);
+      b = 0;
+      for(i = 0; i < len; i++)
+	b = crc_update(b, buf + off + i, 1);
+      nbad += a != b;
+    }
+  return nbad;
+}
+
+/*
+ * crc of file fname: mapped if possible, otherwise read by BUFSIZE
+ * return 0, -1 if it cannot be read
+ */
+int crc_file(const char *fname, uint32_t *crc) {
+  struct stat st;
   ssize_t n;
-  u_int32_t crc;
+  void *pt;
+  int fd;
+
+  if ((fd = open(fname, O_RDONLY)) <  0)
+    return -1;
+  *crc = 0;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+      (pt = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0))
+      != MAP_FAILED) {
+    madvise(pt, st.st_size, MADV_SEQUENTIAL);
+    *crc = crc_update(0, pt, st.st_size);
+    munmap(pt, st.st_size);
+    close(fd);
+    return 0; }
+  while ((n = read(fd, buf, BUFSIZE)) > 0)
+    *crc = crc_update(*crc, buf, n);
+  close(fd);
+  return n < 0 ? -1 : 0;
+}
+
+void usage(const char *progname) {
+  fprintf(stderr, "Usage: %s [-q] <filename>[:<crc>] ...\n"
+	  "       %s -T\n", progname, progname);
+  exit(EXIT_USAGE);
+}
+
+int main(int argc, char **argv) {
+  int i, opt, quiet = 0, res = 0, single;
+  char *sep, *end, *fname;
+  uint32_t crc, expected;
+  int check;
 
-  if (argc != 2) {
-    fprintf(stderr, "Usage: %s <filename>\n", argv[0]);
-    exit(1); }
+  while ((opt = getopt(argc, argv, "qT")) != -1)
+    switch(opt) {
+    case 'q':
+      quiet = 1;
+      break;
+    case 'T':
+      crc_init();
+      if ((i = crc_check()) > 0) {
+	fprintf(stderr, "crc32 self-check: %d differences\n", i);
+	exit(EXIT_CRC); }
+      fprintf(stderr, "crc32 self-check OK\n");
+      exit(0);
+    default:
+      usage(argv[0]);
+    }
+  if (optind >= argc)
+    usage(argv[0]);
 
-  if ((fd = open(argv[1], O_RDONLY)) <  0) {
-    fprintf(stderr, "Cannot open file %s for reading\n", argv[1]);
-    exit(2); }
+  crc_init();
+  single = optind == argc - 1;
+  for (i = optind; i < argc; i++) {
+    fname = argv[i];
+    /* file:crc, a name with ':' not followed by hex stays a name */
+    check = 0;
+    if ((sep = strrchr(fname, ':')) != NULL && sep[1] != '\0') {
+      expected = strtoul(sep + 1, &end, 16);
+      if (*end == '\0') {
+	*sep = '\0';
+	check = 1; }}
 
-  crc = crc32(0L, NULL, 0);
-  while ((n = read(fd, buf, BUFSIZE)) > 0) {
-    crc = crc32(crc, buf, n); }
-  
-  printf("%08x\n", crc);
+    if (crc_file(fname, &crc) < 0) {
+      fprintf(stderr, "Cannot open file %s for reading\n", fname);
+      res = EXIT_READ;
+      continue; }
+    if (check && crc != expected) {
+      printf("%08x  %s FAILED (expected %08x)\n", crc, fname, expected);
+      if (res == 0)
+	res = EXIT_CRC;
+      continue; }
+    if (quiet)
+      continue;
+    if (single && !check)
+      printf("%08x\n", crc);
+    else
+      printf("%08x  %s%s\n", crc, fname, check ? " OK" : "");
+  }
 
-  return 0;
+  return res;
 }
@@ -11,12 +11,23 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <linux/i2c-dev.h>
+#include <linux/i2c.h>
 #include <sys/ioctl.h>
 
 #undef TESTDUMP   // #define if you want to  dump content of registers
 #define IIC_SLAVE_SI5347         0x6C  // The slave address Cleaner Jitter
 const char I2C_DEVICE_NAME[] = "/dev/i2c-1";
+#define I2C_NMSG_MAX 42     // I2C_RDRW_IOCTL_MAX_MSGS of the kernel
+#define I2C_BURST_MAX 64    // data bytes in one auto-increment write
+#define REG_PAGE     0x01   // page register, present on all pages
+#define REG_STATUS   0x0C   // page 0: bit 0 SYSINCAL, calibration running
+#define REG_READY    0xFE   // DEVICE_READY on all pages, 0x0F if ready
+#define POLL_US      1000   // ready polling period
+#define READY_TIMEOUT 1000000  // max. wait for ready/calibration [us]
+#define NPAGES       0x0C   // pages 0x00 - 0x0B
+#define EXIT_VERIFY  2      // exit code if registers differ from table
 
 /*
 # Start configuration preamble
@@ -160,15 +171,43 @@ char buf[]={
     0x00,0x1C,0x01};                                                             // bank 0
 //    0x0B,0x24,0xC0,0x0B,0x25,0x02};                                             // bank B                                    // bank B
 
-#define COMMENT_RESET "Reset"
 void reset_wrong(int file);
 void reset(int file);
 void writeRegs(int file, char* bufdata, int size, const char* comment);
 void initJC(int file);
 int IsJitterCleanerReady(int file);
+int waitReady(int file, int calib);
+int readRegs(int file, int page, unsigned char addr, unsigned char *val,
+	     int n);
+int verifyRegs(int file, char* bufdata, int size);
+void dump(int file);
 
-int main () {
-  int file_i2c;
+// registers of buf[] not kept as written: SOFT_RST_ALL self-clears
+const unsigned short verifySkip[] = { 0x001C };
+
+void usage(const char *progname) {
+  fprintf(stderr, "usage: %s [-c | -C]\n"
+	  "  -c: verify registers against configuration table after init\n"
+	  "  -C: only verify, do not initialize\n"
+	  "  exit code %d if some registers differ\n", progname, EXIT_VERIFY);
+  exit(1);
+}
+
+int main (int argc, char **argv) {
+  int file_i2c, opt, verify = 0, init = 1, res = 0;
+
+  while((opt = getopt(argc, argv, "cC")) != -1)
+    switch(opt) {
+    case 'c':
+      verify = 1;
+      break;
+    case 'C':
+      verify = 1;
+      init = 0;
+      break;
+    default:
+      usage(argv[0]);
+    }
 
   fprintf(stderr, "Initialization of I2C for jitter cleaner ..... ");
   file_i2c = open(I2C_DEVICE_NAME, O_RDWR);
@@ -186,7 +225,10 @@ int main () {
   dump(file_i2c);
 #endif
 
-  initJC(file_i2c);
+  if(init)
+    initJC(file_i2c);
+  if(verify && verifyRegs(file_i2c, buf, sizeof(buf)) != 0)
+    res = EXIT_VERIFY;
 
 #ifdef TESTDUMP
   printf("Register dump after init:\n");
@@ -202,7 +244,7 @@ int main () {
 #endif
   
   close(file_i2c);
-  return 0;
+  return res;
 }
 
 
@@ -228,36 +270,18 @@ int IsJitterCleanerReady(int file) {
 
 //////////////////////////////////////////////////////
 void dump (int file) {
-  int i, j, k, length;
-  static char RecvBuffer[256];
-  char reg[2];
-
-  for (i = 0; i<256; i++) { RecvBuffer[i] = 0;} // set the receiver buffer to 0
+  int i, j, k;
+  static unsigned char RecvBuffer[256];
 
-  for (j = 0x0; j < 0xc; j++)  // read the internal register bank by bank
+  for (j = 0x0; j < NPAGES; j++)  // read the internal register bank by bank
     {
-      reg[0] = 1;
-      reg[1] = j;
-      length = 2;
-      if (write(file, reg, length) != length) {
-	fprintf(stderr, "Error 8\n");
-	exit(1); }
-      usleep (50000);
-      reg[0] = 0;
-      length = 2;
-      if (write(file, reg, length) != length) {
-	fprintf(stderr, "Error 9\n");
+      if (readRegs(file, j, 0, RecvBuffer, 256) < 0) {
+	fprintf(stderr, "Error 10\n");
 	exit(1); }
-      usleep (50000);
 
       printf("#################################################\n\n");
       printf("Bank number: %x \n",j);
 
-      length = 256;
-      if (read(file,RecvBuffer,length)!= length) {
-	fprintf(stderr, "Error 10\n");
-	exit(1); }
-	
       for (i = 0; i<255; i=i+16) {
 	for (k=0; k<16;k++)
 	  fprintf(stderr, " %2x", RecvBuffer[i+k]);
@@ -266,32 +290,190 @@ void dump (int file) {
   printf("-------------------------------------------------\n\n");
 }
 
+//********************************************
+//*    Burst register programming
+// transactions of one I2C_RDWR: page switches and auto-increment writes
+struct i2c_batch {
+  struct i2c_msg msgs[I2C_NMSG_MAX];
+  unsigned char data[I2C_NMSG_MAX * (I2C_BURST_MAX + 1)];
+  int nmsgs, ndata;
+};
+
+// send all messages of batch b, return 0, -1 on error
+int flushBatch(int file, struct i2c_batch *b) {
+  struct i2c_rdwr_ioctl_data rdwr;
+
+  rdwr.msgs = b->msgs;
+  rdwr.nmsgs = b->nmsgs;
+  b->nmsgs = b->ndata = 0;
+  if(rdwr.nmsgs > 0 && ioctl(file, I2C_RDWR, &rdwr) < 0)
+    return -1;
+  return 0;
+}
+
+// start a new write message with its first byte in b
+struct i2c_msg *newMsg(struct i2c_batch *b, unsigned char first) {
+  struct i2c_msg *msg = b->msgs + b->nmsgs++;
+
+  msg->addr = IIC_SLAVE_SI5347;
+  msg->flags = 0;
+  msg->len = 1;
+  msg->buf = b->data + b->ndata;
+  msg->buf[0] = first;
+  b->ndata += I2C_BURST_MAX + 1;
+  return msg;
+}
+
+// write table of (page, address, value) triplets in their order,
+// switch page only when it changes, consecutive addresses in one burst
 void writeRegs(int file, char* bufdata, int size, const char* comment) {
-  int k;
-  unsigned char i2buf[2];
-  
-  // registers config
+  static struct i2c_batch b;
+  struct i2c_msg *msg = NULL;
+  int k, page = -1, next = -1;
+
+  b.nmsgs = b.ndata = 0;
   for ( k = 0; k < size; k=k+3) {
-    i2buf[0] = 0x01;
-    i2buf[1] = bufdata[k];
-    if(write(file, i2buf, 2) < 2) {
-      fprintf(stderr, "Error page set %s @%d\n", comment, k);
-      exit(1); }
-    /* after Hard reset, no ACK on I2C =>
-       write returns -1 with errno=6 'No such device or address' */
-    if( write(file, bufdata + k+1, 2) < 2 &&
-	strcmp(comment, COMMENT_RESET) != 0 ) {
-      fprintf(stderr, "Error register write %s @%d\n", comment, k);
+    unsigned char p = bufdata[k], addr = bufdata[k+1];
+
+    if(p != page || addr != next || msg->len > I2C_BURST_MAX) {
+      if(b.nmsgs + 2 > I2C_NMSG_MAX && flushBatch(file, &b) < 0) {
+	fprintf(stderr, "Error register write %s @%d\n", comment, k);
+	exit(1); }
+      if(p != page) {
+	msg = newMsg(&b, REG_PAGE);
+	msg->buf[msg->len++] = p;
+	page = p; }
+      msg = newMsg(&b, addr);
+    }
+    msg->buf[msg->len++] = bufdata[k+2];
+    next = addr + 1;
+  }
+  if(flushBatch(file, &b) < 0) {
+    fprintf(stderr, "Error register write %s\n", comment);
+    exit(1); }
+}
+
+// read register reg of the current page to val, return 0, -1 on error
+int readReg(int file, unsigned char reg, unsigned char *val) {
+  struct i2c_msg msgs[2] = {
+    { IIC_SLAVE_SI5347, 0, 1, &reg },
+    { IIC_SLAVE_SI5347, I2C_M_RD, 1, val }};
+  struct i2c_rdwr_ioctl_data rdwr = { msgs, 2 };
+
+  return ioctl(file, I2C_RDWR, &rdwr) < 0 ? -1 : 0;
+}
+
+// read n registers from addr of page to val by auto-increment
+// return 0, -1 on error
+int readRegs(int file, int page, unsigned char addr, unsigned char *val,
+	     int n) {
+  unsigned char pg[2] = { REG_PAGE, page };
+  struct i2c_msg msgs[3] = {
+    { IIC_SLAVE_SI5347, 0, 2, pg },
+    { IIC_SLAVE_SI5347, 0, 1, &addr },
+    { IIC_SLAVE_SI5347, I2C_M_RD, n, val }};
+  struct i2c_rdwr_ioctl_data rdwr = { msgs, 3 };
+
+  return ioctl(file, I2C_RDWR, &rdwr) < 0 ? -1 : 0;
+}
+
+// poll until device is ready and, if calib, its calibration is done
+// the device does not ACK for a while after hard reset: retry errors
+// return 1, 0 on READY_TIMEOUT
+int waitReady(int file, int calib) {
+  unsigned char val, page[2] = { REG_PAGE, 0x00 };
+  int t;
+
+  for(t = 0; t < READY_TIMEOUT; t += POLL_US) {
+    if(readReg(file, REG_READY, &val) == 0 && val == 0x0F) {
+      if(!calib)
+	return 1;
+      if(write(file, page, 2) == 2 && readReg(file, REG_STATUS, &val) == 0
+	 && (val & 0x01) == 0)
+	return 1;
+    }
+    usleep(POLL_US);
+  }
+  return 0;
+}
+
+//********************************************
+//*    Verify registers against table
+// burst read only the registers present in table bufdata, each page
+// in I2C_RDWR batches of address write and read of consecutive ones;
+// print mismatches and summary on one line
+// return number of differing registers, exit on I2C error
+int verifyRegs(int file, char* bufdata, int size) {
+  static unsigned char expect[NPAGES][256], got[NPAGES][256];
+  static unsigned char present[NPAGES][256], ident[256];
+  struct i2c_msg msgs[I2C_NMSG_MAX];
+  struct i2c_rdwr_ioctl_data rdwr = { msgs, 0 };
+  unsigned char pg[2] = { REG_PAGE, 0 };
+  int k, p, a, n, nregs = 0, nbad = 0;
+
+  memset(present, 0, sizeof(present));
+  for(k = 0; k < size; k += 3) {
+    p = (unsigned char)bufdata[k];
+    a = (unsigned char)bufdata[k+1];
+    if(p >= NPAGES)
+      continue;
+    nregs += !present[p][a];
+    present[p][a] = 1;
+    expect[p][a] = bufdata[k+2];  // the last write counts
+  }
+  for(k = 0; k < sizeof(verifySkip) / sizeof(verifySkip[0]); k++)
+    if(present[verifySkip[k] >> 8][verifySkip[k] & 0xFF]) {
+      present[verifySkip[k] >> 8][verifySkip[k] & 0xFF] = 0;
+      nregs--; }
+  for(a = 0; a < 256; a++)
+    ident[a] = a;
+
+  fprintf(stderr, "Verify of Jitter cleaner .... ");
+  for(p = 0; p < NPAGES; p++) {
+    pg[1] = p;
+    msgs[0] = (struct i2c_msg){ IIC_SLAVE_SI5347, 0, 2, pg };
+    rdwr.nmsgs = 1;
+    for(a = 0; a < 256; a += n) {
+      for(n = 0; a + n < 256 && present[p][a + n]; n++)
+	;
+      if(n == 0) {
+	n = 1;
+	continue; }
+      msgs[rdwr.nmsgs++] = (struct i2c_msg){ IIC_SLAVE_SI5347, 0, 1,
+					      ident + a };
+      msgs[rdwr.nmsgs++] = (struct i2c_msg){ IIC_SLAVE_SI5347, I2C_M_RD,
+					      n, got[p] + a };
+      if(rdwr.nmsgs + 2 > I2C_NMSG_MAX) {
+	if(ioctl(file, I2C_RDWR, &rdwr) < 0) {
+	  fprintf(stderr, "Error register read page %x\n", p);
+	  exit(1); }
+	rdwr.nmsgs = 0; }
+    }
+    if(rdwr.nmsgs > 1 && ioctl(file, I2C_RDWR, &rdwr) < 0) {
+      fprintf(stderr, "Error register read page %x\n", p);
       exit(1); }
   }
+
+  for(p = 0; p < NPAGES; p++)
+    for(a = 0; a < 256; a++)
+      if(present[p][a] && got[p][a] != expect[p][a]) {
+	fprintf(stderr, "[%02x%02x]%02x:%02x,", p, a, expect[p][a], got[p][a]);
+	nbad++; }
+  if(nbad)
+    fprintf(stderr, " %d of %d registers differ\n", nbad, nregs);
+  else
+    fprintf(stderr, "%d registers OK\n", nregs);
+  return nbad;
 }
 
 void initJC(int file) {
   fprintf(stderr, "Initialization of Jitter cleaner .... ");
   reset(file);
-  usleep (300000); // delay 300ms after hard reset
+  if(!waitReady(file, 0))  // was: delay 300ms after hard reset
+    fprintf(stderr, "not ready after reset, continuing .... ");
   writeRegs(file, bufEric, sizeof(bufEric), "Preamble");
-  usleep (300000); // delay 300ms 
+  if(!waitReady(file, 1))  // was: delay 300ms for running calibration
+    fprintf(stderr, "calibration not finished, continuing .... ");
   writeRegs(file, buf, sizeof(buf), "All registers");
   fprintf(stderr, "OK\n");
 }
@@ -304,8 +486,17 @@ void reset_wrong(int file) {
 }
 
 void reset(int file) {
+  unsigned char page[2] = { REG_PAGE, 0x00 };
+
   if(IsJitterCleanerReady(file) == 0) {
     fprintf(stderr, "Error 5\n");
     exit(1); }
-  writeRegs(file, bufHardReset, sizeof(bufHardReset), COMMENT_RESET);
+  page[1] = bufHardReset[0];
+  if(write(file, page, 2) < 2) {
+    fprintf(stderr, "Error page set Reset\n");
+    exit(1); }
+  /* after Hard reset, no ACK on I2C =>
+     write returns -1 with errno=6 'No such device or address', ignore it */
+  if(write(file, bufHardReset + 1, 2) < 2)
+    return;
 }
@@ -0,0 +1,170 @@
+/* SPI access to ADC AD9268 registers, see adc_spi.h */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+#include "adc_spi.h"
+
+static void spi_error_exit(int err, int fd, const char *msg) {
+  fprintf(stderr, "%s\n", msg);
+  exit(1);
+}
+
+void (*spi_error)(int err, int fd, const char *msg) = spi_error_exit;
+
+int openspidev(int adc) {
+  int fd;
+  char filename[32];
+
+  snprintf(filename, 19, "/dev/spidev32766.%d", adc);
+  fd = open(filename, O_RDWR);
+  if (fd < 0) {
+    snprintf(filename, sizeof(filename), "Cannot open SPI device %d", adc);
+    spi_error(SPI_EOPEN, adc, filename);
+    return -1; }
+  return fd;
+}
+
+int spi_init(int adcfd) {
+  static uint8_t mode = 0;
+  static uint8_t bits = 8;
+  static uint32_t speed = 5000000;
+
+  // spi mode
+  if (ioctl(adcfd, SPI_IOC_WR_MODE, &mode) == -1) {
+    spi_error(SPI_EWRMODE, adcfd, "Cannot set SPI write mode");
+    return -1; }
+  if (ioctl(adcfd, SPI_IOC_RD_MODE, &mode) == -1) {
+    spi_error(SPI_ERDMODE, adcfd, "Cannot set SPI read mode");
+    return -1; }
+
+  // bits per word
+  if (ioctl(adcfd, SPI_IOC_WR_BITS_PER_WORD, &bits) == -1 ||
+      ioctl(adcfd, SPI_IOC_RD_BITS_PER_WORD, &bits) == -1) {
+    spi_error(SPI_EBITPERW, adcfd, "Cannot set bits per word");
+    return -1; }
+
+  // max speed hz
+  if (ioctl(adcfd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) == -1) {
+    spi_error(SPI_EWRSPEED, adcfd, "Cannot set max wr speed");
+    return -1; }
+  if (ioctl(adcfd, SPI_IOC_RD_MAX_SPEED_HZ, &speed) == -1) {
+    spi_error(SPI_ERDSPEED, adcfd, "Cannot set max rd speed");
+    return -1; }
+  return 0;
+}
+
+int adc_read(int adcfd, int address) {
+  struct spi_ioc_transfer xfer[2];
+  unsigned char buf[32];
+
+  memset(xfer, 0, sizeof xfer);
+  memset(buf, 0, sizeof buf);
+
+  buf[0] = 0x80 | ((address>>8) & 0xff);
+  buf[1] = address & 0xff;
+
+  xfer[0].tx_buf = (unsigned long) buf;
+  xfer[0].len = 2;
+
+  xfer[1].rx_buf = (unsigned long) buf;
+  xfer[1].len = 1;
+
+  if (ioctl(adcfd, SPI_IOC_MESSAGE(2), xfer) < 0) {
+    spi_error(SPI_EREAD, adcfd, "SPI_IOC_MESSAGE");
+    return -1; }
+  return ((int) buf[0]);
+}
+
+int adc_write(int adcfd, int address, int cmd) {
+  char cmdstr[3];
+
+  cmdstr[0] = (address>>8) & 0xff;
+  cmdstr[1] = address & 0xff;
+  cmdstr[2] = cmd;
+
+  if (write(adcfd, cmdstr, sizeof(cmdstr)) != sizeof(cmdstr)) {
+    spi_error(SPI_EWRITE, adcfd, "adc_write");
+    return -1; }
+  return 1;
+}
+
+/*
+ * up to ADC_BATCH_MAX registers of adc_write_regs() in one message:
+ * write transfer, for checked registers followed by address and read
+ * transfers; chip select is released after each register
+ */
+static int adc_batch(int adcfd, const struct adc_reg *regs, int n,
+		     uint8_t *rb) {
+  struct spi_ioc_transfer xfer[3*ADC_BATCH_MAX];
+  uint8_t cmd[ADC_BATCH_MAX][5];  /* write: addr, val; read: addr */
+  int i, nx = 0, ncheck = 0;
+
+  memset(xfer, 0, sizeof(xfer));
+  for(i = 0; i < n; i++) {
+    cmd[i][0] = (regs[i].addr>>8) & 0xff;
+    cmd[i][1] = regs[i].addr & 0xff;
+    cmd[i][2] = regs[i].val;
+    xfer[nx].tx_buf = (unsigned long) cmd[i];
+    xfer[nx].len = 3;
+    xfer[nx++].cs_change = 1;
+    if(!regs[i].check)
+      continue;
+    cmd[i][3] = 0x80 | cmd[i][0];
+    cmd[i][4] = cmd[i][1];
+    xfer[nx].tx_buf = (unsigned long) (cmd[i] + 3);
+    xfer[nx++].len = 2;
+    xfer[nx].rx_buf = (unsigned long) (rb + i);
+    xfer[nx].len = 1;
+    xfer[nx++].cs_change = 1;
+    ncheck++;
+  }
+  xfer[nx-1].cs_change = 0;  /* last one releases chip select anyway */
+
+  if (ioctl(adcfd, SPI_IOC_MESSAGE(nx), xfer) < 0) {
+    spi_error(ncheck ? SPI_EREAD : SPI_EWRITE, adcfd, "SPI_IOC_MESSAGE");
+    return -1; }
+  ncheck = 0;
+  for(i = 0; i < n; i++)
+    if(regs[i].check && rb[i] != regs[i].val)
+      ncheck++;
+  return ncheck;
+}
+
+int adc_write_regs(int adcfd, const struct adc_reg *regs, int n, uint8_t *rb) {
+  uint8_t rbuf[ADC_BATCH_MAX];
+  int i, k, res, nbad = 0;
+
+  for(i = 0; i < n; i += k) {
+    k = n - i < ADC_BATCH_MAX ? n - i : ADC_BATCH_MAX;
+    if((res = adc_batch(adcfd, regs + i, k, rb ? rb + i : rbuf)) < 0)
+      return -1;
+    nbad += res;
+  }
+  return nbad;
+}
+
+const struct adc_reg adc_init_regs[ADC_NINIT_REGS] = {
+  { ADC_ADDR_CHS, ADC_CHS_AB, 1 },  // select both channels A and B
+  { 0x0008, 0x03, 1 },  // digital reset operation (AD9268.pdf, p.41)
+  { 0x0008, 0x00, 1 },
+  { 0x0000, 0x3c, 0 },  // SPI config: Soft reset, read returns 0x18
+  { 0x0014, 0xa4, 1 },  // output mode LVDS inverted
+  { 0x0018, 0x04, 1 },  // VREF select:  2.0V p-p
+  { ADC_ADDR_TEST, ADC_TEST_OFF, 1 },  // test mode off (normal mode)
+};
+
+int adc_testmode(int adcfd, int chans, int mode) {
+  struct adc_reg regs[2] = {
+    { ADC_ADDR_CHS, 0, 0 },
+    { ADC_ADDR_TEST, 0, 0 }};
+
+  regs[0].val = chans & ADC_CHS_AB;
+  regs[1].val = mode;
+  return adc_write_regs(adcfd, regs, 2, NULL);
+}
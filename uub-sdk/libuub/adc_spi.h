@@ -0,0 +1,62 @@
+#ifndef ADC_SPI_H
+#define ADC_SPI_H
+
+/* SPI access to ADC AD9268 registers */
+
+#include <stdint.h>
+
+/* errors passed to spi_error */
+#define SPI_EOPEN     1
+#define SPI_EWRMODE   2
+#define SPI_ERDMODE   3
+#define SPI_EBITPERW  4
+#define SPI_EWRSPEED  5
+#define SPI_ERDSPEED  6
+#define SPI_EWRITE    7
+#define SPI_EREAD     8
+
+/* called on SPI error with the failing fd (adc number for SPI_EOPEN)
+   default prints msg to stderr and exits with 1
+   if it returns, the failing function returns -1 */
+extern void (*spi_error)(int err, int fd, const char *msg);
+
+/* open /dev/spidev32766.<adc> and return its fd */
+int openspidev(int adc);
+/* set mode 0, 8 bits per word and 5 MHz, return 0 */
+int spi_init(int adcfd);
+/* return value of register address */
+int adc_read(int adcfd, int address);
+/* write cmd to register address, return 1 */
+int adc_write(int adcfd, int address, int cmd);
+
+/* register write of a sequence, optionally read back */
+struct adc_reg {
+  uint16_t addr;
+  uint8_t val;
+  uint8_t check;   /* read back after write */
+};
+#define ADC_BATCH_MAX 32  /* registers in one SPI_IOC_MESSAGE */
+
+/* write n registers in order, each batch of ADC_BATCH_MAX in one
+   SPI_IOC_MESSAGE; store read back value of checked ones in rb[i]
+   (rb may be NULL) and compare them after the transfer
+   return number of checked registers differing from val, -1 on error */
+int adc_write_regs(int adcfd, const struct adc_reg *regs, int n, uint8_t *rb);
+
+/* channel select and test mode registers */
+#define ADC_ADDR_CHS  0x05
+#define ADC_ADDR_TEST 0x0D
+#define ADC_CHS_AB    0x03  /* both channels A and B */
+#define ADC_TEST_OFF  0x00  /* normal mode */
+#define ADC_TEST_RAMP 0x0F
+
+/* initialization sequence, adc_write_regs(fd, adc_init_regs,
+   ADC_NINIT_REGS, rb) writes it in one SPI message */
+#define ADC_NINIT_REGS 7
+extern const struct adc_reg adc_init_regs[ADC_NINIT_REGS];
+
+/* set test mode (ADC_TEST_*) of channels chans (bit 0 A, bit 1 B)
+   return as adc_write_regs */
+int adc_testmode(int adcfd, int chans, int mode);
+
+#endif /* ADC_SPI_H */
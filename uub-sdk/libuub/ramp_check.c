@@ -0,0 +1,154 @@
+/* Evaluation of ADC traces in ramp test mode, see ramp_check.h */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+#include "ramp_check.h"
+#include "shwr_split.h"
+
+void ramp_stats_init(struct ramp_stats rstats[SHWR_NCH_MAX]) {
+  int i;
+
+  memset(rstats, 0, SHWR_NCH_MAX * sizeof(rstats[0]));
+  for( i = 0; i < SHWR_NCH_MAX; i++ )
+    rstats[i].firstshot = rstats[i].firstindex = -1;
+}
+
+void ramp_traces(const uint32_t *databuf, const struct shwr_header *sh,
+		 uint16_t traces[][SHWR_NSAMPLES]) {
+  int adc;
+  for (adc = 0; adc < SHWR_RAW_NCH_MAX; adc ++ )
+    shwr_split(databuf + adc*SHWR_NSAMPLES, SHWR_NSAMPLES, sh->shwr_buf_start,
+	       traces[2*adc], traces[2*adc + 1]);
+}
+
+/*
+ * count wrong bits of samples y[i, i+n) against ramp (base - i) into st
+ * return number of wrong samples
+ */
+static unsigned ramp_errors(const uint16_t *y, int i, int n, unsigned base,
+			    int shot, struct ramp_stats *st) {
+  unsigned bit, nbad = 0;
+  uint16_t err;
+
+  for( ; n > 0; i++, n-- ) {
+    if(( err = y[i] ^ ((base - i) % SHWR_MAX_VAL) ) == 0 )
+      continue;
+    if( st->firstindex < 0 ) {
+      st->firstshot = shot;
+      st->firstindex = i; }
+    for( bit = 0; bit < SHWR_NBITS; bit++ )
+      st->biterr[bit] += (err >> bit) & 1;
+    nbad++;
+  }
+  return nbad;
+}
+
+/*
+ * number of wrong bits of trace y against ramp (base - i)
+ */
+static unsigned ramp_bits(const uint16_t *y, unsigned base) {
+  unsigned i, nbits = 0;
+
+  for( i = 0; i < SHWR_NSAMPLES; i++ )
+    nbits += __builtin_popcount(y[i] ^ ((base - i) % SHWR_MAX_VAL));
+  return nbits;
+}
+
+/*
+ * compare trace y with a ramp, trace[i] = (base - i) % SHWR_MAX_VAL,
+ * base is the most frequent trace[i] + i, so a bad first sample does not
+ * hide the other errors; a stuck bit makes two offsets equally frequent,
+ * the one with less wrong bits is taken; check all samples
+ * return number of wrong samples, statistics accumulated in st
+ */
+unsigned check_ramp(const uint16_t *y, int shot, struct ramp_stats *st) {
+  static uint16_t hist[SHWR_MAX_VAL + 1];  /* the last one stays 0 */
+  unsigned i, x, base, second, nbad = 0;
+#ifdef __ARM_NEON__
+  static const uint16_t idx0[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  const uint16x8_t mask = vdupq_n_u16(SHWR_MAX_VAL - 1);
+  uint16x8_t idx, vbase, err;
+  uint16x4_t any;
+#endif
+
+  memset(hist, 0, sizeof(hist));
+  base = y[0];
+  second = SHWR_MAX_VAL;
+  for( i = 0; i < SHWR_NSAMPLES; i++ ) {
+    x = (y[i] + i) % SHWR_MAX_VAL;
+    if( ++hist[x] > hist[base] ) {
+      second = base;
+      base = x;
+    } else if( x != base && hist[x] > hist[second] )
+      second = x;
+  }
+  if( 2*hist[second] >= hist[base]
+      && ramp_bits(y, second) < ramp_bits(y, base) )
+    base = second;
+
+#ifdef __ARM_NEON__
+  /* vector compare of 8 samples, count bits only where any differs */
+  idx = vld1q_u16(idx0);
+  vbase = vdupq_n_u16(base);
+  for( i = 0; i < SHWR_NSAMPLES; i += 8 ) {
+    err = veorq_u16(vld1q_u16(y + i), vandq_u16(vsubq_u16(vbase, idx), mask));
+    any = vorr_u16(vget_low_u16(err), vget_high_u16(err));
+    if( vget_lane_u64(vreinterpret_u64_u16(any), 0) != 0 )
+      nbad += ramp_errors(y, i, 8, base, shot, st);
+    idx = vaddq_u16(idx, vdupq_n_u16(8));
+  }
+#else
+  nbad = ramp_errors(y, 0, SHWR_NSAMPLES, base, shot, st);
+#endif
+  if( nbad > 0 )
+    st->badshots++;
+  st->badsamples += nbad;
+  return nbad;
+}
+
+/*
+ * check all channels, accumulate statistics to rstats
+ * return bit mask of failing ADCs
+ */
+int evaluate_ramp(uint16_t trace[][SHWR_NSAMPLES], int shot,
+		  struct ramp_stats rstats[SHWR_NCH_MAX]) {
+  int ch, result;
+  result = 0;
+  for( ch = 0; ch < SHWR_NCH_MAX; ch++ )
+    if( check_ramp(trace[ch], shot, rstats + ch) > 0 )
+      result |= 1 << (ch/2);
+  return result;
+}
+
+/*
+ * print ramp statistics of failing (or all if verbose) channels
+ */
+void report_ramp(const struct ramp_stats rstats[SHWR_NCH_MAX], int nshots,
+		 int verbose) {
+  int ch, bit;
+  const struct ramp_stats *st;
+
+  for( ch = 0; ch < SHWR_NCH_MAX; ch++ ) {
+    st = rstats + ch;
+    if( st->badshots == 0 && !verbose )
+      continue;
+    fprintf(stderr, "ADC %d %s: %u/%d shots bad, %u wrong samples",
+	    ch/2, ch % 2 ? "LG" : "HG", st->badshots, nshots, st->badsamples);
+    if( st->firstindex >= 0 ) {
+      fprintf(stderr, ", first shot %d index %d\n  bit errors (11..0):",
+	      st->firstshot, st->firstindex);
+      for( bit = SHWR_NBITS - 1; bit >= 0; bit-- )
+	fprintf(stderr, " %u", st->biterr[bit]); }
+    fputs("\n", stderr);
+  }
+}
+
+void LED_trigger(void) {
+  gl.regs[LED_CONTROL_ADDR] = 0;  //TURN OFF LEDS
+  gl.regs[LED_CONTROL_ADDR] = 1;  //Do led pulse now
+  usleep(100);  //if you do not wait, there is no reading
+}
@@ -0,0 +1,46 @@
+#ifndef RAMP_CHECK_H
+#define RAMP_CHECK_H
+
+/* Evaluation of ADC traces taken in ramp test mode (ADC_TEST_RAMP)
+   each sample should be (base - i) % SHWR_MAX_VAL
+   NEON accelerated when built with -mfpu=neon */
+
+#include <stdint.h>
+#include "read_evt.h"
+
+/* from shwr_evt_defs.h */
+#define SHWR_MAX_VAL (1 << 12)
+#define SHWR_NBITS 12
+
+/* ramp errors of one channel accumulated over shots */
+struct ramp_stats {
+  unsigned badshots;      /* shots with any wrong sample */
+  unsigned badsamples;    /* wrong samples in all shots */
+  unsigned biterr[SHWR_NBITS];  /* wrong bits by bit position */
+  int firstshot, firstindex;    /* first wrong sample, -1 if none */
+};
+
+/* clear statistics of all SHWR_NCH_MAX channels */
+void ramp_stats_init(struct ramp_stats rstats[SHWR_NCH_MAX]);
+
+/* split raw shower memory buffer of sh (DATASIZE) into HG/LG traces */
+void ramp_traces(const uint32_t *databuf, const struct shwr_header *sh,
+		 uint16_t traces[][SHWR_NSAMPLES]);
+
+/* compare trace y with a ramp, accumulate statistics in st
+   return number of wrong samples */
+unsigned check_ramp(const uint16_t *y, int shot, struct ramp_stats *st);
+
+/* check all channels, accumulate statistics to rstats
+   return bit mask of failing ADCs */
+int evaluate_ramp(uint16_t trace[][SHWR_NSAMPLES], int shot,
+		  struct ramp_stats rstats[SHWR_NCH_MAX]);
+
+/* print ramp statistics of failing (or all if verbose) channels */
+void report_ramp(const struct ramp_stats rstats[SHWR_NCH_MAX], int nshots,
+		 int verbose);
+
+/* fire one LED pulse, the trigger mask must include SHWR_BUF_TRIG_LED */
+void LED_trigger(void);
+
+#endif /* RAMP_CHECK_H */
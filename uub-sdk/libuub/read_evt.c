@@ -0,0 +1,446 @@
+/* Readout of shower and muon buffers of SDE trigger, see read_evt.h */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+#include "read_evt.h"
+
+static unsigned int shwr_addr[SHWR_RAW_NCH_MAX] = {
+  TRIGGER_MEMORY_SHWR0_BASE,
+  TRIGGER_MEMORY_SHWR1_BASE,
+  TRIGGER_MEMORY_SHWR2_BASE,
+  TRIGGER_MEMORY_SHWR3_BASE,
+  TRIGGER_MEMORY_SHWR4_BASE
+};
+static unsigned int muon_addr[MUON_NMEM] = {
+  TRIGGER_MEMORY_MUON0_BASE,
+  TRIGGER_MEMORY_MUON1_BASE
+};
+
+struct read_evt_global gl;
+void (*read_evt_hook)(struct shwr_header *sh) = NULL;
+
+/*
+ * current time in us, not affected by clock adjustments
+ */
+long long time_us(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+  return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+/*
+ *  round up <n> to multiple of <multiple>
+ */
+unsigned roundup(unsigned n, unsigned multiple) {
+  return ((n + multiple-1) / multiple) * multiple;
+}
+
+/*
+ * mmap regs and shwr_pt, muon_pt if <muon> from /dev/mem
+ * if <uiodev> is not NULL, open it for the shower interrupt
+ */
+static int read_evt_map(const char *uiodev, int muon) {
+  int i, fd, size;
+  void * pt;
+
+  if((fd = open("/dev/mem",O_RDWR)) < 0 ) {
+    fprintf(stderr, "Error opening /dev/mem\n");
+    return READ_EVT_EDEVMEM; }
+
+  size = roundup(256*sizeof(uint32_t), PAGESIZE);
+  gl.regs_size = size;
+  pt = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+	    SDE_TRIGGER_BASE);
+  if(pt == MAP_FAILED) {
+    fprintf(stderr, "Error mapping regs\n");
+    return READ_EVT_EMAPTRIG; }
+  gl.regs = (uint32_t *)pt;
+
+  pt = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+	    TIME_TAGGING_BASE);
+  if(pt == MAP_FAILED) {
+    fprintf(stderr, "Error mapping tt_regs\n");
+    return READ_EVT_EMAPTIME; }
+  gl.tt_regs = (uint32_t *)pt;
+
+  pt = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+	    TEST_CONTROL_BASE);
+  if(pt == MAP_FAILED) {
+    fprintf(stderr, "Error mapping tstctl_regs\n");
+    return READ_EVT_EMAPTEST; }
+  gl.tstctl_regs = (uint32_t *)pt;
+
+  size = roundup(SHWR_MEM_DEPTH * SHWR_MEM_NBUF, PAGESIZE);
+  gl.shwr_mem_size = size;
+  for( i = 0; i < SHWR_RAW_NCH_MAX; i++ ) {
+    pt = mmap(NULL,size, PROT_READ, MAP_SHARED, fd, shwr_addr[i]);
+    if(pt == MAP_FAILED) {
+      fprintf(stderr, "Error mapping shower buf %d\n", i);
+      return READ_EVT_EMAPSHWR; }
+    gl.shwr_pt[i] = (uint32_t *) pt;
+  }
+
+  if(muon) {
+    size = roundup(MUON_MEM_DEPTH * MUON_MEM_NBUF, PAGESIZE);
+    gl.muon_mem_size = size;
+    for(i = 0; i < MUON_NMEM; i++) {
+      pt = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, muon_addr[i]);
+      if(pt == MAP_FAILED) {
+	fprintf(stderr, "Error mapping muon buf %d\n", i);
+	return READ_EVT_EMAPMUON; }
+      gl.muon_pt[i] = (uint32_t *)pt;
+    }
+    if(uiodev != NULL) {
+      fprintf(stderr, "muon buffers are polled, %s not used\n", uiodev);
+      uiodev = NULL; }
+  }
+
+  /* shower buffer full interrupt delivered through UIO */
+  gl.evtfd = -1;
+  if(uiodev != NULL) {
+    pt = mmap(NULL, gl.regs_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+	      SDE_SHWR_TRIGGER_INTR_BASE);
+    if(pt == MAP_FAILED) {
+      fprintf(stderr, "Error mapping intr_regs\n");
+      return READ_EVT_EMAPINTR; }
+    if((gl.evtfd = open(uiodev, O_RDWR)) < 0) {
+      fprintf(stderr, "Cannot open %s, polling each %d ns\n",
+	      uiodev, WAITTIME);
+      munmap(pt, gl.regs_size);
+    } else {
+      gl.intr_regs = (uint32_t *)pt;
+      gl.intr_regs[INTR_ACK_ADDR] = 1;
+      gl.intr_regs[INTR_EN_ADDR] = 1;
+      gl.intr_regs[INTR_GLOBAL_EN_ADDR] = 1;
+    }
+  }
+  close(fd);
+  return 0;
+}
+
+/*
+ * mmap regs and shwr_pt, muon_pt if <muon>, simulated if selected
+ * by READ_EVT_SIM (or built with -DREAD_EVT_SIM)
+ * if <uiodev> is not NULL, wait for the shower interrupt on it,
+ * otherwise (or if it cannot be opened or muon) poll each WAITTIME
+ */
+int read_evt_init(const char *uiodev, int muon) {
+  const char *spec;
+  int res;
+
+  spec = getenv(READ_EVT_SIM_ENV);
+#ifdef READ_EVT_SIM
+  if(spec == NULL)
+    spec = READ_EVT_SIM_DEFAULT;
+#endif
+  gl.evtfd = -1;
+  if(spec != NULL && strcmp(spec, "off") != 0)
+    res = read_evt_sim_init(spec, muon);
+  else
+    res = read_evt_map(uiodev, muon);
+  if(res != 0)
+    return res;
+
+  /* bitstream without interrupt: wake up periodically
+     and check if there is an event */
+  if(gl.evtfd < 0) {
+    if((gl.evtfd = timerfd_create(CLOCK_MONOTONIC, 0)) < 0) {
+      fprintf(stderr, "timer creation error\n");
+      return READ_EVT_ETIMER; }
+    if(read_evt_arm(1) != 0){
+      fprintf(stderr, "timer setting error\n");
+      return READ_EVT_ESETTIME; }
+  }
+
+  gl.nowait = 0;
+  gl.id_counter=0;
+  gl.muon_counter = 0;
+  return 0;
+}
+
+/*
+ * start (on) or stop polling timer, nothing to do with UIO interrupt
+ * return 0, -1 on error
+ */
+int read_evt_arm(int on) {
+  struct itimerspec ts;
+
+  if(gl.intr_regs != NULL)
+    return 0;
+  ts.it_interval.tv_sec = 0;
+  ts.it_interval.tv_nsec = on ? WAITTIME : 0;
+  ts.it_value.tv_sec = 0;
+  ts.it_value.tv_nsec = on ? WAITTIME : 0;  /*the next interruption */
+  return timerfd_settime(gl.evtfd, 0, &ts, NULL) != 0 ? -1 : 0;
+}
+
+void read_evt_end(void) {
+  int i;
+
+  if(gl.sim) {
+    read_evt_sim_end();
+    if(gl.evtfd >= 0)
+      close(gl.evtfd);
+    return; }
+
+  if(gl.regs != NULL)
+    munmap((void *)gl.regs, gl.regs_size);
+
+  if(gl.tt_regs != NULL)
+    munmap((void *)gl.tt_regs, gl.regs_size);
+
+  if(gl.tstctl_regs != NULL)
+      munmap((void *)gl.tstctl_regs, gl.regs_size);
+
+  if(gl.intr_regs != NULL) {
+    gl.intr_regs[INTR_GLOBAL_EN_ADDR] = 0;
+    munmap((void *)gl.intr_regs, gl.regs_size); }
+
+  if(gl.evtfd >= 0)
+    close(gl.evtfd);
+
+  for( i=0; i < SHWR_RAW_NCH_MAX; i++ ) {
+    if(gl.shwr_pt[i] != NULL)
+      munmap((void *)gl.shwr_pt[i], gl.shwr_mem_size); }
+
+  for(i = 0; i < MUON_NMEM; i++) {
+    if(gl.muon_pt[i] != NULL)
+      munmap((void *)gl.muon_pt[i], gl.muon_mem_size); }
+}
+
+/*
+ * return EVT_DATA if a shower buffer is full, | EVT_MUON if a muon one is
+ */
+int read_evt_full(void) {
+  int evt = 0;
+
+  if(gl.sim)
+    read_evt_sim_update();
+  if(gl.regs[SHWR_BUF_STATUS_ADDR] &
+     (SHWR_BUF_NFULL_MASK << SHWR_BUF_NFULL_SHIFT))
+    evt = EVT_DATA;
+  if(gl.muon_pt[0] != NULL && gl.regs[MUON_BUF_STATUS_ADDR] &
+     (MUON_BUF_NFULL_MASK << MUON_BUF_NFULL_SHIFT))
+    evt |= EVT_MUON;
+  return evt;
+}
+
+/*
+ * wait until a shower (or muon) buffer is full or <ctrlsock> or <tfd>
+ * is readable (ctrlsock, tfd < 0 to ignore them)
+ * if <xfd> >= 0, wait for it instead of shower buffers
+ * return EVT_DATA, EVT_MUON, EVT_XFD, EVT_CTRL and/or EVT_TIMER,
+ * 0 if interrupted, -1 on error
+ */
+int read_evt_wait(int ctrlsock, int xfd, int tfd) {
+  struct pollfd pfd[3];
+  uint64_t expirations;
+  uint32_t irq;
+  int res, timeout, evt, full;
+
+  pfd[0].fd = gl.evtfd;
+  pfd[0].events = POLLIN;
+  pfd[1].fd = ctrlsock;
+  pfd[1].events = POLLIN;
+  pfd[2].fd = tfd;
+  pfd[2].events = POLLIN;
+
+  if(xfd >= 0) {
+    pfd[0].fd = xfd;
+    if(poll(pfd, 3, -1) < 0)
+      return (errno == EINTR) ? 0 : -1;
+    return ((pfd[0].revents & POLLIN) ? EVT_XFD : 0) |
+      ((pfd[1].revents & POLLIN) ? EVT_CTRL : 0) |
+      ((pfd[2].revents & POLLIN) ? EVT_TIMER : 0);
+  }
+
+  for(;;) {
+    if((full = read_evt_full())) {
+      if(++gl.nowait < NOWAIT_MAX)
+	return full;
+      timeout = 0;  /* buffers never empty, look at ctrlsock anyway */
+    } else
+      timeout = -1;
+    gl.nowait = 0;
+    if(gl.intr_regs != NULL) {  /* unmask UIO interrupt */
+      irq = 1;
+      if(write(gl.evtfd, &irq, sizeof(irq)) != sizeof(irq))
+	return -1; }
+    if((res = poll(pfd, 3, timeout)) < 0) {
+      if(errno == EINTR)
+	continue;
+      return -1; }
+    if(res == 0)
+      return full;
+    evt = ((pfd[1].revents & POLLIN) ? EVT_CTRL : 0) |
+      ((pfd[2].revents & POLLIN) ? EVT_TIMER : 0);
+    if(evt)
+      return evt | read_evt_full();
+    if(pfd[0].revents & POLLIN) {
+      if(gl.intr_regs != NULL) {
+	if(read(gl.evtfd, &irq, sizeof(irq)) != sizeof(irq))
+	  return -1;
+	gl.intr_regs[INTR_ACK_ADDR] = 1;
+      } else if(read(gl.evtfd, &expirations, sizeof(expirations))
+		!= sizeof(expirations))
+	return -1;
+    }
+  }
+}
+
+/*
+ * fill shwr_header of the current full buffer without reading it out
+ * the buffer must be released by read_evt_release(sh->rd)
+ * return 0, -1 if no buffer full
+ */
+int read_evt_header(struct shwr_header* sh) {
+  uint32_t status;
+
+  if(gl.sim)
+    read_evt_sim_update();
+  status = gl.regs[SHWR_BUF_STATUS_ADDR];
+  if((status & (SHWR_BUF_NFULL_MASK << SHWR_BUF_NFULL_SHIFT)) == 0)
+    return(-1);
+  sh->id = gl.id_counter;
+  sh->shwr_buf_status   = status;
+  sh->shwr_buf_start    = gl.regs[SHWR_BUF_START_ADDR];
+  sh->shwr_buf_trig_id  = gl.regs[SHWR_BUF_TRIG_ID_ADDR];
+  sh->ttag_shwr_seconds = gl.tt_regs[TTAG_SHWR_SECONDS_ADDR];
+  sh->ttag_shwr_nanosec = gl.tt_regs[TTAG_SHWR_NANOSEC_ADDR];
+  sh->rd = ((status >> SHWR_BUF_RNUM_SHIFT) & SHWR_BUF_RNUM_MASK);
+  sh->size = DATASIZE;
+  gl.id_counter = (gl.id_counter + 1) & ID_MASK;
+  if(read_evt_hook != NULL)
+    read_evt_hook(sh);
+  return(0);
+}
+
+/*
+ * release shower buffer rd
+ */
+void read_evt_release(int rd) {
+  gl.regs[SHWR_BUF_CONTROL_ADDR] = rd;
+  if(gl.sim)
+    read_evt_sim_release(0);
+}
+
+/*
+ * fill seg with shower memory of buffer rd, one segment per channel
+ */
+void read_evt_segments(int rd, struct iovec seg[SHWR_RAW_NCH_MAX]) {
+  int i;
+
+  for(i = 0; i < SHWR_RAW_NCH_MAX; i++) {
+    seg[i].iov_base = (void *)(gl.shwr_pt[i] + rd * SHWR_NSAMPLES);
+    seg[i].iov_len = sizeof(uint32_t)*SHWR_NSAMPLES;
+  }
+}
+
+/*
+ * read out FADC to buf and fill shwr_header
+ * expects full buffer (see read_evt_wait)
+ * return time for data acquisition in us, -1 if no buffer full
+ */
+long long read_evt_read(struct shwr_header* sh, uint8_t *buf) {
+  void *pt_aux;
+  uint32_t *fadc;
+  int i;
+  int offset;
+  long long duration;
+
+  fadc = (uint32_t *)buf;
+
+  duration = - time_us();
+  if(read_evt_header(sh) < 0)
+    return(-1);
+  offset = sh->rd * SHWR_NSAMPLES;
+  for(i = 0; i < SHWR_RAW_NCH_MAX; i++){
+    pt_aux = (void *)(gl.shwr_pt[i] + offset);
+    memcpy(fadc, pt_aux, sizeof(uint32_t)*SHWR_NSAMPLES);
+    fadc += SHWR_NSAMPLES;
+  }
+  read_evt_release(sh->rd);
+  duration += time_us();
+  return(duration);
+}
+
+/*
+ * fill header of the current full muon buffer without reading it out
+ * (see read_evt.h), the buffer must be released by read_muon_release()
+ * return 0, -1 if no buffer full
+ */
+int read_muon_header(struct shwr_header* sh) {
+  uint32_t status, nwords;
+
+  if(gl.sim)
+    read_evt_sim_update();
+  status = gl.regs[MUON_BUF_STATUS_ADDR];
+  if((status & (MUON_BUF_NFULL_MASK << MUON_BUF_NFULL_SHIFT)) == 0)
+    return(-1);
+  sh->id = MUON_ID | gl.muon_counter;
+  sh->shwr_buf_status   = status;
+  sh->shwr_buf_start    = gl.regs[MUON_BUF_TIME_TAG_A_ADDR];
+  sh->shwr_buf_trig_id  = gl.regs[MUON_BUF_TIME_TAG_B_ADDR];
+  sh->ttag_shwr_seconds = gl.tt_regs[TTAG_MUON_SECONDS_ADDR];
+  sh->ttag_shwr_nanosec = gl.tt_regs[TTAG_MUON_NANOSEC_ADDR];
+  sh->rd = ((status >> MUON_BUF_RNUM_SHIFT) & MUON_BUF_RNUM_MASK);
+  if((nwords = gl.regs[MUON_BUF_WORD_COUNT_ADDR]) > MUON_MAXWORDS)
+    nwords = MUON_MAXWORDS;
+  sh->size = sizeof(uint32_t) * MUON_NMEM * nwords;
+  gl.muon_counter = (gl.muon_counter + 1) & ID_MASK;
+  if(read_evt_hook != NULL)
+    read_evt_hook(sh);
+  return(0);
+}
+
+/*
+ * release muon buffer rd
+ */
+void read_muon_release(int rd) {
+  gl.regs[MUON_BUF_CONTROL_ADDR] = rd;
+  if(gl.sim)
+    read_evt_sim_release(1);
+}
+
+/*
+ * fill seg with used muon memory of the buffer in muon header sh
+ */
+void read_muon_segments(struct shwr_header *sh, struct iovec seg[MUON_NMEM]) {
+  int i;
+
+  for(i = 0; i < MUON_NMEM; i++) {
+    seg[i].iov_base = (void *)(gl.muon_pt[i] + sh->rd * MUON_MEM_WORDS);
+    seg[i].iov_len = sh->size / MUON_NMEM;
+  }
+}
+
+/*
+ * read out a full muon buffer to buf and fill header
+ * return time for data acquisition in us, -1 if no buffer full
+ */
+long long read_muon_read(struct shwr_header* sh, uint8_t *buf) {
+  struct iovec seg[MUON_NMEM];
+  long long duration;
+  int i;
+
+  duration = - time_us();
+  if(read_muon_header(sh) < 0)
+    return(-1);
+  read_muon_segments(sh, seg);
+  for(i = 0; i < MUON_NMEM; i++) {
+    memcpy(buf, seg[i].iov_base, seg[i].iov_len);
+    buf += seg[i].iov_len;
+  }
+  read_muon_release(sh->rd);
+  duration += time_us();
+  return(duration);
+}
@@ -0,0 +1,152 @@
+#ifndef READ_EVT_H
+#define READ_EVT_H
+
+/* Readout of shower and muon buffers of SDE trigger
+   built for one FPGA version (include dir with its sde_trigger_defs.h)
+   registers and memories are mapped into the global gl */
+
+#include <stdint.h>
+#include <sys/uio.h>
+#include "sde_trigger_defs.h"
+#include "time_tagging.h"
+#include "test_control_defs.h"
+#ifndef TEST_CONTROL_BASE
+  #define TEST_CONTROL_BASE XPAR_TEST_CONTROL_BLOCK_TEST_CONTROL_0_S00_AXI_BASEADDR
+#endif
+
+#define WAITTIME 10000   /* wait time [ns] between checking data available */
+#define NOWAIT_MAX 64    /* check other descriptors at least every NOWAIT_MAX evts */
+
+/* from shwr_evt_defs.h */
+#define SHWR_RAW_NCH_MAX 5
+#define SHWR_NCH_MAX (2*SHWR_RAW_NCH_MAX)
+#define SHWR_NSAMPLES 2048
+#define MUON_NMEM 2
+
+#define PAGESIZE (sysconf(_SC_PAGESIZE))
+#define DATASIZE (sizeof(uint32_t) * SHWR_NSAMPLES * SHWR_RAW_NCH_MAX)
+/* muon payload must fit 16-bit fragment offsets, a full buffer loses a word */
+#define MUON_MAXWORDS (MUON_MEM_WORDS - 1)
+#define MUONSIZE (sizeof(uint32_t) * MUON_MAXWORDS * MUON_NMEM)
+#define MUON_ID 0x40000000  /* muon event ids, separate from shower ones */
+/* event counter bits of ids, below MUON_ID, AVERAGE_ID (udp_frame.h)
+   and the header flag 0x80000000 */
+#define ID_MASK 0x1FFFFFFF
+
+/* read_evt_wait events */
+#define EVT_DATA  1   /* shower buffer full */
+#define EVT_CTRL  2   /* datagram on control socket */
+#define EVT_XFD   4   /* extra descriptor readable */
+#define EVT_TIMER 8   /* timer descriptor readable */
+#define EVT_MUON 16   /* muon buffer full */
+
+/* read_evt_init errors, messages go to stderr */
+#define READ_EVT_EDEVMEM  1
+#define READ_EVT_EMAPTRIG 2
+#define READ_EVT_EMAPTIME 3
+#define READ_EVT_EMAPTEST 4
+#define READ_EVT_EMAPSHWR 5
+#define READ_EVT_EMAPMUON 6
+#define READ_EVT_ETIMER   7
+#define READ_EVT_ESETTIME 8
+#define READ_EVT_EMAPINTR 9
+#define READ_EVT_ESIM    10
+
+/* simulation backend instead of /dev/mem: "<rate>[,ramp|pulse][,<file>]"
+   in environment READ_EVT_SIM, triggers at rate Hz (0: whenever a buffer
+   is free) with ramp (default) or pulse traces, regs and memories in
+   file if given, otherwise anonymous; built with -DREAD_EVT_SIM (make
+   SIM=y) simulated unless READ_EVT_SIM=off */
+#define READ_EVT_SIM_ENV "READ_EVT_SIM"
+#define READ_EVT_SIM_DEFAULT "100"
+#define TTAG_TICS_HZ 120000000  /* time tagging clock, TTAG_*_NANOSEC */
+
+struct shwr_header {
+  uint32_t id;
+  uint32_t shwr_buf_status, shwr_buf_start, shwr_buf_trig_id;
+  uint32_t ttag_shwr_seconds, ttag_shwr_nanosec;
+  uint32_t rd;
+  uint32_t format;   /* payload format, left to the caller */
+  uint32_t size;     /* payload size in bytes */
+};
+
+struct read_evt_global {
+  uint32_t id_counter;
+  uint32_t volatile *shwr_pt[SHWR_RAW_NCH_MAX];
+  int shwr_mem_size;
+  uint32_t muon_counter;
+  uint32_t volatile *muon_pt[MUON_NMEM];  /* NULL if muon stream disabled */
+  int muon_mem_size;
+
+  uint32_t volatile *regs;
+  uint32_t volatile *tt_regs;
+  uint32_t volatile *tstctl_regs;
+  uint32_t volatile *intr_regs;  /* shower interrupt regs, NULL if no UIO */
+  int regs_size;
+
+  int evtfd;   /* UIO device or timerfd to wait on */
+  int nowait;  /* number of events read without waiting */
+  int sim;     /* simulation backend, see read_evt_sim.c */
+};
+
+extern struct read_evt_global gl;
+/* if not NULL, called by read_evt_header and read_muon_header for each
+   new header while its buffer is still not released */
+extern void (*read_evt_hook)(struct shwr_header *sh);
+
+/* round up n to multiple of multiple */
+unsigned roundup(unsigned n, unsigned multiple);
+
+/* current time in us, not affected by clock adjustments */
+long long time_us(void);
+
+/* mmap regs and shower memories, muon memories if muon
+   if uiodev is not NULL, wait for the shower interrupt on it,
+   otherwise (or if it cannot be opened or muon) poll each WAITTIME
+   simulated if selected by READ_EVT_SIM (uiodev not used)
+   return 0 or READ_EVT_E* */
+int read_evt_init(const char *uiodev, int muon);
+void read_evt_end(void);
+/* start/stop polling each WAITTIME (started by read_evt_init), a process
+   idle for long may stop it; no effect with UIO; return 0, -1 on error */
+int read_evt_arm(int on);
+
+/* return EVT_DATA if a shower buffer is full, | EVT_MUON if a muon one is */
+int read_evt_full(void);
+
+/* wait until a shower (or muon) buffer is full or ctrlsock or tfd
+   is readable (ctrlsock, tfd < 0 to ignore them)
+   if xfd >= 0, wait for it instead of shower buffers
+   return EVT_DATA, EVT_MUON, EVT_XFD, EVT_CTRL and/or EVT_TIMER,
+   0 if interrupted, -1 on error */
+int read_evt_wait(int ctrlsock, int xfd, int tfd);
+
+/* fill sh of the current full shower buffer without reading it out,
+   the buffer must be released by read_evt_release(sh->rd)
+   return 0, -1 if no buffer full */
+int read_evt_header(struct shwr_header *sh);
+void read_evt_release(int rd);
+/* fill seg with shower memory of buffer rd, one segment per channel */
+void read_evt_segments(int rd, struct iovec seg[SHWR_RAW_NCH_MAX]);
+/* read out a full shower buffer to buf (DATASIZE) and fill sh
+   return time for data acquisition in us, -1 if no buffer full */
+long long read_evt_read(struct shwr_header *sh, uint8_t *buf);
+
+/* the same for muon buffers: id | MUON_ID, shwr_buf_status:
+   MUON_BUF_STATUS, shwr_buf_start: MUON_BUF_TIME_TAG_A, shwr_buf_trig_id:
+   MUON_BUF_TIME_TAG_B, ttag_shwr_*: TTAG_MUON_*; payload size/8 words of
+   MUON0 memory followed by the same number of MUON1 words */
+int read_muon_header(struct shwr_header *sh);
+void read_muon_release(int rd);
+void read_muon_segments(struct shwr_header *sh, struct iovec seg[MUON_NMEM]);
+long long read_muon_read(struct shwr_header *sh, uint8_t *buf);
+
+/* simulation backend, used by read_evt_init/read_evt_end
+   read_evt_sim_update generates the due triggers and sets the regs,
+   read_evt_sim_release frees the oldest shower/muon buffer */
+int read_evt_sim_init(const char *spec, int muon);
+void read_evt_sim_update(void);
+void read_evt_sim_release(int muon);
+void read_evt_sim_end(void);
+
+#endif /* READ_EVT_H */
@@ -0,0 +1,294 @@
+/* Simulation backend of read_evt, see read_evt.h
+   regs and memories in one anonymous (or file) mapping, laid out as the
+   mappings of read_evt_init; triggers generated at the given rate when
+   the buffer state is looked at, like a free running trigger; a trigger
+   with all buffers full is lost, as in the dead time of the FPGA */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "read_evt.h"
+
+#define SIM_WAVE_RAMP  0
+#define SIM_WAVE_PULSE 1
+#define SIM_ADC_MASK 0xfff    /* 12 bit ADC */
+#define SIM_PULSE_LEN 256     /* samples of pulse shape */
+#define SIM_PULSE_TAU 20.0    /* decay time [samples] */
+#define SIM_PULSE_POS (SHWR_NSAMPLES - SHWR_TRIG_DLY)  /* trace sample */
+#define SIM_BASE_HG 256
+#define SIM_BASE_LG 64
+#define SIM_MUON_MINWORDS 64
+
+struct simbuf {
+  unsigned wr, rd, nfull;
+  uint64_t lost;
+  uint32_t start[SHWR_MEM_NBUF], trig_id[SHWR_MEM_NBUF];
+  uint32_t sec[SHWR_MEM_NBUF], nsec[SHWR_MEM_NBUF];
+};
+
+static struct {
+  int rate, wave, muon;
+  long long t0;            /* time_us() at start */
+  struct timespec rt0;     /* realtime at start */
+  uint64_t ntrig;          /* triggers generated */
+  uint32_t seed;
+  struct simbuf shwr, muonb;
+  void *base;
+  size_t size;
+  float shape[SIM_PULSE_LEN];
+} sim;
+
+/* pseudo-random numbers for amplitudes and noise */
+static uint32_t sim_rand(void) {
+  sim.seed ^= sim.seed << 13;
+  sim.seed ^= sim.seed >> 17;
+  sim.seed ^= sim.seed << 5;
+  return sim.seed;
+}
+
+/*
+ * parse spec "<rate>[,ramp|pulse][,<file>]", map regs and memories
+ * return 0 or READ_EVT_ESIM
+ */
+int read_evt_sim_init(const char *spec, int muon) {
+  char buf[256], *tok, *end, *file = NULL;
+  uint8_t *pt;
+  double decay = 1;
+  int i, fd;
+
+  memset(&sim, 0, sizeof(sim));
+  snprintf(buf, sizeof(buf), "%s", spec);
+  sim.rate = strtol(buf, &end, 10);
+  if(end == buf || (*end != ',' && *end != '\0') || sim.rate < 0) {
+    fprintf(stderr, "Invalid simulation rate in '%s'\n", spec);
+    return READ_EVT_ESIM; }
+  for(tok = *end ? strtok(end + 1, ",") : NULL; tok != NULL;
+      tok = strtok(NULL, ",")) {
+    if(strcmp(tok, "ramp") == 0)
+      sim.wave = SIM_WAVE_RAMP;
+    else if(strcmp(tok, "pulse") == 0)
+      sim.wave = SIM_WAVE_PULSE;
+    else
+      file = tok;
+  }
+  sim.muon = muon;
+
+  gl.regs_size = roundup(256*sizeof(uint32_t), PAGESIZE);
+  gl.shwr_mem_size = roundup(SHWR_MEM_DEPTH * SHWR_MEM_NBUF, PAGESIZE);
+  gl.muon_mem_size = roundup(MUON_MEM_DEPTH * MUON_MEM_NBUF, PAGESIZE);
+  sim.size = 3 * gl.regs_size + SHWR_RAW_NCH_MAX * gl.shwr_mem_size
+    + (muon ? MUON_NMEM * gl.muon_mem_size : 0);
+  if(file != NULL) {
+    if((fd = open(file, O_RDWR | O_CREAT, 0644)) < 0
+       || ftruncate(fd, sim.size) != 0) {
+      fprintf(stderr, "Cannot create simulation file %s\n", file);
+      return READ_EVT_ESIM; }
+    pt = mmap(NULL, sim.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+  } else
+    pt = mmap(NULL, sim.size, PROT_READ | PROT_WRITE,
+	      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(pt == MAP_FAILED) {
+    fprintf(stderr, "Error mapping simulated regs\n");
+    return READ_EVT_ESIM; }
+  memset(pt, 0, sim.size);
+  sim.base = pt;
+  gl.regs = (uint32_t *)pt;
+  gl.tt_regs = (uint32_t *)(pt += gl.regs_size);
+  gl.tstctl_regs = (uint32_t *)(pt += gl.regs_size);
+  pt += gl.regs_size;
+  for(i = 0; i < SHWR_RAW_NCH_MAX; i++, pt += gl.shwr_mem_size)
+    gl.shwr_pt[i] = (uint32_t *)pt;
+  for(i = 0; muon && i < MUON_NMEM; i++, pt += gl.muon_mem_size)
+    gl.muon_pt[i] = (uint32_t *)pt;
+  gl.intr_regs = NULL;
+
+  /* fast rise in 3 samples, exponential decay */
+  for(i = 0; i < SIM_PULSE_LEN; i++) {
+    sim.shape[i] = i < 3 ? (i + 1) / 3.0 : decay;
+    if(i >= 3)
+      decay *= 1 - 1 / SIM_PULSE_TAU;
+  }
+  sim.seed = 0x2545F491;
+  sim.t0 = time_us();
+  clock_gettime(CLOCK_REALTIME, &sim.rt0);
+  gl.sim = 1;
+  fprintf(stderr, "simulated trigger %d Hz, %s\n", sim.rate,
+	  sim.wave == SIM_WAVE_PULSE ? "pulse" : "ramp");
+  return 0;
+}
+
+/*
+ * trace of one ADC for trigger k at buffer position start: ramps as in
+ * ADC test mode (trace[i] = (base - i), see ramp_check.h) or a pulse
+ * at SIM_PULSE_POS on a noisy baseline, LG 1/32 of HG
+ */
+static void sim_trace(uint32_t *mem, unsigned start, uint64_t k, int ch) {
+  unsigned i, hg, lg, j, base;
+  float amp;
+
+  if(sim.wave == SIM_WAVE_RAMP) {
+    base = (k * 13 + ch * 512) & SIM_ADC_MASK;
+    for(i = 0; i < SHWR_NSAMPLES; i++, start++) {
+      if(start == SHWR_NSAMPLES)
+	start = 0;
+      mem[start] = ((base - i) & SIM_ADC_MASK)
+	| (((base + 256 - i) & SIM_ADC_MASK) << 16);
+    }
+    return;
+  }
+  amp = 50 + sim_rand() % 3000;
+  for(i = 0; i < SHWR_NSAMPLES; i++, start++) {
+    if(start == SHWR_NSAMPLES)
+      start = 0;
+    hg = SIM_BASE_HG + (sim_rand() & 3);
+    lg = SIM_BASE_LG;
+    if((j = i - SIM_PULSE_POS) < SIM_PULSE_LEN) {
+      hg += amp * sim.shape[j];
+      lg += amp * sim.shape[j] / 32;
+      if(hg > SIM_ADC_MASK)
+	hg = SIM_ADC_MASK; }
+    mem[start] = hg | (lg << 16);
+  }
+}
+
+/* time tag of trigger k at ts into the write buffer of b: seconds,
+   tics of TTAG_TICS_HZ and event counter as the time tagging module */
+static void sim_ttag(struct simbuf *b, uint64_t k, struct timespec *ts) {
+  b->sec[b->wr] = ts->tv_sec & TTAG_SECONDS_MASK;
+  b->nsec[b->wr] = (uint32_t)(ts->tv_nsec * (TTAG_TICS_HZ / 1e9))
+    | (k & TTAG_EVTCTR_MASK) << TTAG_EVTCTR_SHIFT;
+}
+
+/*
+ * shower trigger k (and muon one) into the write buffers if free
+ */
+static void sim_trigger(uint64_t k, struct timespec *ts) {
+  struct simbuf *b = &sim.shwr;
+  uint32_t *mem, nwords;
+  unsigned i;
+  int ch;
+
+  if(b->nfull < SHWR_MEM_NBUF) {
+    b->start[b->wr] = (k * 1237) % SHWR_NSAMPLES;
+    b->trig_id[b->wr] = ((k & SHWR_EVT_ID_MASK) << SHWR_EVT_ID_SHIFT)
+      | (gl.regs[SHWR_BUF_TRIG_MASK_ADDR] & 0xff);
+    sim_ttag(b, k, ts);
+    for(ch = 0; ch < SHWR_RAW_NCH_MAX; ch++)
+      sim_trace((uint32_t *)gl.shwr_pt[ch] + b->wr * SHWR_NSAMPLES,
+		b->start[b->wr], k, ch);
+    b->wr = (b->wr + 1) % SHWR_MEM_NBUF;
+    b->nfull++;
+  } else
+    b->lost += sim.rate > 0;  /* none lost when triggered on demand */
+
+  b = &sim.muonb;
+  if(!sim.muon)
+    return;
+  if(b->nfull < MUON_MEM_NBUF) {
+    nwords = SIM_MUON_MINWORDS
+      + (k * 97) % (MUON_MAXWORDS - SIM_MUON_MINWORDS);
+    b->start[b->wr] = nwords;   /* word count */
+    b->trig_id[b->wr] = k;
+    sim_ttag(b, k, ts);
+    for(ch = 0; ch < MUON_NMEM; ch++) {
+      mem = (uint32_t *)gl.muon_pt[ch] + b->wr * MUON_MEM_WORDS;
+      for(i = 0; i < nwords; i++)
+	mem[i] = ((uint32_t)k << 16) | (ch << 15) | i;
+    }
+    b->wr = (b->wr + 1) % MUON_MEM_NBUF;
+    b->nfull++;
+  } else
+    b->lost += sim.rate > 0;
+}
+
+/* status register of shower (muon if muon) buffers b: rnum, wnum,
+   full flags and nfull */
+static uint32_t sim_status(struct simbuf *b, int muon) {
+  unsigned nbuf = muon ? MUON_MEM_NBUF : SHWR_MEM_NBUF;
+  uint32_t full;
+
+  full = ((1 << b->nfull) - 1) << b->rd;
+  full = (full | full >> nbuf) & ((1 << nbuf) - 1);
+  if(muon)
+    return b->rd << MUON_BUF_RNUM_SHIFT | b->wr << MUON_BUF_WNUM_SHIFT
+      | full << MUON_BUF_FULL_SHIFT | b->nfull << MUON_BUF_NFULL_SHIFT;
+  return b->rd << SHWR_BUF_RNUM_SHIFT | b->wr << SHWR_BUF_WNUM_SHIFT
+    | full << SHWR_BUF_FULL_SHIFT | b->nfull << SHWR_BUF_NFULL_SHIFT;
+}
+
+/*
+ * generate triggers due since start, update status and the regs of
+ * the buffers to read
+ */
+void read_evt_sim_update(void) {
+  struct simbuf *b = &sim.shwr, *m = &sim.muonb;
+  struct timespec ts;
+  uint64_t due;
+  long long ns;
+
+  if(sim.rate == 0) {  /* trigger whenever a buffer is free */
+    clock_gettime(CLOCK_REALTIME, &ts);
+    while(b->nfull < SHWR_MEM_NBUF
+	  || (sim.muon && m->nfull < MUON_MEM_NBUF))
+      sim_trigger(sim.ntrig++, &ts);
+  } else {
+    due = (time_us() - sim.t0) * sim.rate / 1000000;
+    /* the buffers could take at most SHWR_MEM_NBUF of a long idle time */
+    if(due > sim.ntrig + SHWR_MEM_NBUF) {
+      b->lost += due - SHWR_MEM_NBUF - sim.ntrig;
+      m->lost += sim.muon ? due - SHWR_MEM_NBUF - sim.ntrig : 0;
+      sim.ntrig = due - SHWR_MEM_NBUF; }
+    for(; sim.ntrig < due; sim.ntrig++) {
+      ns = sim.rt0.tv_nsec + sim.ntrig * 1000000000ULL / sim.rate;
+      ts.tv_sec = sim.rt0.tv_sec + ns / 1000000000;
+      ts.tv_nsec = ns % 1000000000;
+      sim_trigger(sim.ntrig, &ts);
+    }
+  }
+
+  gl.regs[SHWR_BUF_STATUS_ADDR] = sim_status(b, 0);
+  gl.regs[SHWR_BUF_START_ADDR] = b->start[b->rd];
+  gl.regs[SHWR_BUF_TRIG_ID_ADDR] = b->trig_id[b->rd];
+  gl.tt_regs[TTAG_SHWR_SECONDS_ADDR] = b->sec[b->rd];
+  gl.tt_regs[TTAG_SHWR_NANOSEC_ADDR] = b->nsec[b->rd];
+  if(!sim.muon)
+    return;
+  gl.regs[MUON_BUF_STATUS_ADDR] = sim_status(m, 1);
+  gl.regs[MUON_BUF_WORD_COUNT_ADDR] = m->start[m->rd];
+  gl.regs[MUON_BUF_TIME_TAG_A_ADDR] = m->trig_id[m->rd];
+  gl.regs[MUON_BUF_TIME_TAG_B_ADDR] = 0;
+  gl.tt_regs[TTAG_MUON_SECONDS_ADDR] = m->sec[m->rd];
+  gl.tt_regs[TTAG_MUON_NANOSEC_ADDR] = m->nsec[m->rd];
+}
+
+/*
+ * release the oldest full shower (muon if muon) buffer
+ */
+void read_evt_sim_release(int muon) {
+  struct simbuf *b = muon ? &sim.muonb : &sim.shwr;
+  unsigned nbuf = muon ? MUON_MEM_NBUF : SHWR_MEM_NBUF;
+
+  if(b->nfull > 0) {
+    b->nfull--;
+    b->rd = (b->rd + 1) % nbuf; }
+  read_evt_sim_update();
+}
+
+/*
+ * unmap simulated regs and memories, report lost triggers
+ */
+void read_evt_sim_end(void) {
+  if(sim.base == NULL)
+    return;
+  fprintf(stderr, "simulated %llu triggers, lost %llu shower %llu muon\n",
+	  (unsigned long long)sim.ntrig, (unsigned long long)sim.shwr.lost,
+	  (unsigned long long)sim.muonb.lost);
+  munmap(sim.base, sim.size);
+  sim.base = NULL;
+  gl.sim = 0;
+}
@@ -0,0 +1,53 @@
+/* real-time mode setup, see rt_setup.h */
+
+#define _GNU_SOURCE   /* CPU_SET */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include "rt_setup.h"
+
+/*
+ * write RT_STACKSIZE of stack below the caller
+ */
+void __attribute__((noinline)) prefault_stack(void) {
+  uint8_t stack[RT_STACKSIZE];
+
+  memset(stack, 0, sizeof(stack));
+  __asm__ __volatile__("" : : "r"(stack) : "memory");  /* keep memset */
+}
+
+/*
+ * real-time mode: pin current thread to cpu, lock all memory,
+ * prefault stack and nbuf buffers; report each step to stderr
+ * return number of failed steps
+ */
+int rt_setup(int cpu, struct iovec *buf, int nbuf) {
+  cpu_set_t cpus;
+  size_t size = 0;
+  int i, nfail = 0;
+
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  if(sched_setaffinity(0, sizeof(cpus), &cpus) < 0) {
+    fprintf(stderr, "rt: pinning to cpu %d failed: %s\n", cpu,
+	    strerror(errno));
+    nfail++;
+  } else
+    fprintf(stderr, "rt: pinned to cpu %d\n", cpu);
+  if(mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+    fprintf(stderr, "rt: mlockall failed: %s\n", strerror(errno));
+    nfail++;
+  } else
+    fprintf(stderr, "rt: memory locked\n");
+  prefault_stack();
+  for(i = 0; i < nbuf; i++) {
+    memset(buf[i].iov_base, 0, buf[i].iov_len);
+    size += buf[i].iov_len; }
+  fprintf(stderr, "rt: prefaulted %d kB of stack and %zu kB of buffers\n",
+	  RT_STACKSIZE / 1024, size / 1024);
+  return nfail;
+}
+
@@ -0,0 +1,18 @@
+#ifndef RT_SETUP_H
+#define RT_SETUP_H
+
+/* real-time mode setup of acquisition threads */
+
+#include <sys/uio.h>
+
+#define RT_STACKSIZE (64*1024)  /* stack prefaulted in real-time mode */
+
+/* write RT_STACKSIZE of stack below the caller */
+void prefault_stack(void);
+
+/* pin current thread to cpu, lock all memory, prefault stack
+   and nbuf buffers; report each step to stderr
+   return number of failed steps */
+int rt_setup(int cpu, struct iovec *buf, int nbuf);
+
+#endif /* RT_SETUP_H */
@@ -0,0 +1,94 @@
+/* Split raw shower memory words into HG and LG traces, see shwr_split.h */
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "shwr_split.h"
+
+/*
+ * split count consecutive raw words into hg and lg
+ */
+static void split_seg(const uint32_t *raw, unsigned count,
+		      uint16_t *hg, uint16_t *lg) {
+  unsigned i = 0;
+#ifdef __ARM_NEON__
+  const uint16x8_t mask = vdupq_n_u16(0xfff);
+  uint16x8x2_t v;
+
+  /* vld2 deinterleaves low (HG) and high (LG) halves of 8 words */
+  for(; i + 8 <= count; i += 8) {
+    v = vld2q_u16((const uint16_t *)(raw + i));
+    vst1q_u16(hg + i, vandq_u16(v.val[0], mask));
+    vst1q_u16(lg + i, vandq_u16(v.val[1], mask));
+  }
+#elif defined(__SSE2__)
+  const __m128i mask = _mm_set1_epi32(0xfff);
+  __m128i a, b;
+
+  /* host build: mask 12 bits of each half, pack 32 to 16 bits */
+  for(; i + 8 <= count; i += 8) {
+    a = _mm_loadu_si128((const __m128i *)(raw + i));
+    b = _mm_loadu_si128((const __m128i *)(raw + i + 4));
+    _mm_storeu_si128((__m128i *)(hg + i),
+		     _mm_packs_epi32(_mm_and_si128(a, mask),
+				     _mm_and_si128(b, mask)));
+    a = _mm_and_si128(_mm_srli_epi32(a, 16), mask);
+    b = _mm_and_si128(_mm_srli_epi32(b, 16), mask);
+    _mm_storeu_si128((__m128i *)(lg + i), _mm_packs_epi32(a, b));
+  }
+#endif
+  for(; i < count; i++) {
+    hg[i] = raw[i] & 0xfff;
+    lg[i] = (raw[i] >> 16) & 0xfff;
+  }
+}
+
+void shwr_split(const uint32_t *raw, unsigned n, unsigned start,
+		uint16_t *hg, uint16_t *lg) {
+  /* ring rotation as two linear segments */
+  split_seg(raw + start, n - start, hg, lg);
+  split_seg(raw, start, hg + n - start, lg + n - start);
+}
+
+void shwr_split_ref(const uint32_t *raw, unsigned n, unsigned start,
+		    uint16_t *hg, uint16_t *lg) {
+  const uint32_t *cur_ptr = raw + start, *stop_ptr = raw + n;
+  unsigned i;
+
+  for(i = 0; i < n; i++) {
+    hg[i] = *cur_ptr & 0xfff;
+    lg[i] = (*cur_ptr >> 16) & 0xfff;
+    if(++cur_ptr == stop_ptr)
+      cur_ptr = raw;
+  }
+}
+
+unsigned shwr_split_check(unsigned n) {
+  uint32_t *raw;
+  uint16_t *y;
+  unsigned i, start, nbad = 0;
+
+  raw = malloc(n * sizeof(uint32_t));
+  y = malloc(4 * n * sizeof(uint16_t));
+  if(raw == NULL || y == NULL) {
+    free(raw);
+    free(y);
+    return n; }
+  /* all bits set at random, split must mask them */
+  srand(n);
+  for(i = 0; i < n; i++)
+    raw[i] = (uint32_t)rand() << 16 ^ rand();
+  for(start = 0; start < n; start++) {
+    shwr_split(raw, n, start, y, y + n);
+    shwr_split_ref(raw, n, start, y + 2*n, y + 3*n);
+    if(memcmp(y, y + 2*n, 2 * n * sizeof(uint16_t)) != 0)
+      nbad++;
+  }
+  free(raw);
+  free(y);
+  return nbad;
+}
@@ -0,0 +1,23 @@
+#ifndef SHWR_SPLIT_H
+#define SHWR_SPLIT_H
+
+/* Split raw shower memory words into HG and LG traces
+   raw word of one ADC: HG in bits 0-11, LG in bits 16-27,
+   the trace starts at shwr_buf_start and wraps around the buffer
+   NEON accelerated when built with -mfpu=neon, SSE2 on the host */
+
+#include <stdint.h>
+
+/* split n raw words of one ADC into hg and lg, rotated by start < n */
+void shwr_split(const uint32_t *raw, unsigned n, unsigned start,
+		uint16_t *hg, uint16_t *lg);
+
+/* scalar reference of shwr_split, the original convert_databuf loop */
+void shwr_split_ref(const uint32_t *raw, unsigned n, unsigned start,
+		    uint16_t *hg, uint16_t *lg);
+
+/* compare shwr_split with shwr_split_ref on pseudo-random words of n samples
+   for all start positions, return number of mismatching ones */
+unsigned shwr_split_check(unsigned n);
+
+#endif /* SHWR_SPLIT_H */
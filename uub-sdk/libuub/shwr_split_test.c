@@ -0,0 +1,23 @@
+/* Host test of shwr_split: the vectorised split against shwr_split_ref
+   for the shower buffer size and short traces ending in a scalar tail
+   exit status 1 if any differs; run by make test HOST=y */
+
+#include <stdio.h>
+#include "read_evt.h"
+#include "shwr_split.h"
+
+int main() {
+  unsigned n, nbad, rc = 0;
+
+  for(n = 1; n <= SHWR_NSAMPLES; n = n < 64 ? n + 1 : SHWR_NSAMPLES) {
+    if((nbad = shwr_split_check(n)) > 0) {
+      fprintf(stderr, "shwr_split differs from reference for %u of %u"
+	      " start positions\n", nbad, n);
+      rc = 1; }
+    if(n == SHWR_NSAMPLES)
+      break;
+  }
+  if(rc == 0)
+    fprintf(stderr, "shwr_split OK\n");
+  return rc;
+}
@@ -1,4 +0,0 @@
-#ifndef _TRIGGER_OPTIONS
-  #define _TRIGGER_OPTIONS
-  #define COMPILE_DATE 0x13120220
-#endif
@@ -0,0 +1,190 @@
+/* bench_gen
+   netscope traffic generator: send events by the netscope framing
+   (senddata) at a given trigger rate, replayed from a record file
+   (struct shwr_header + payload, as written by bench_recv -w) or
+   synthetic raw ramps; ttag_shwr_* carry the send time (CLOCK_REALTIME)
+   for latency measured by bench_recv
+   summary printed to stdout as one JSON object
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "read_evt.h"
+#include "udp_frame.h"
+
+#define DEST "127.0.0.1"
+#define DATAPORT 8888
+#define RATE 100         /* default trigger rate [events/s] */
+#define NEVENTS 1000     /* default number of events */
+#define NRECORDS 256     /* max. records replayed from file */
+
+/* global variables */
+struct destlist dest;
+struct shwr_header rech[NRECORDS];
+uint8_t *recdata[NRECORDS];
+int nrec = 0;
+
+void printhelp(char *progname) {
+  fprintf(stderr, "Usage: %s [-d <addr[:port]>] [-r <rate>] [-n <events>]"
+	  " [-m <size>] [-f <file>]\n"
+	  "      -d: destination (default %s:%d), up to %d times\n"
+	  "      -r: trigger rate [events/s] (default %d), 0 as fast as"
+	  " possible\n"
+	  "      -n: number of events (default %d)\n"
+	  "      -m: datagram size (%d - %d, default %d)\n"
+	  "      -f: replay up to %d records from file cyclically instead of\n"
+	  "          synthetic raw ramps\n",
+	  progname, DEST, DATAPORT, NDEST_MAX, RATE, NEVENTS,
+	  PACKETSIZE_MIN, PACKETSIZE_MAX, PACKETSIZE, NRECORDS);
+}
+
+/*
+ * read records (struct shwr_header + payload of size) from fname
+ * return number of records
+ */
+int read_records(const char *fname) {
+  FILE *fp;
+  int n;
+
+  if((fp = fopen(fname, "r")) == NULL) {
+    fprintf(stderr, "Cannot open file '%s'\n", fname);
+    exit(1); }
+  for(n = 0; n < NRECORDS; n++) {
+    if(fread(rech + n, sizeof(struct shwr_header), 1, fp) != 1)
+      break;
+    if(rech[n].size > FRAME_MAXSIZE
+       || (recdata[n] = malloc(rech[n].size)) == NULL
+       || fread(recdata[n], 1, rech[n].size, fp) != rech[n].size) {
+      fprintf(stderr, "Invalid record %d in '%s'\n", n, fname);
+      exit(1); }
+  }
+  fclose(fp);
+  return n;
+}
+
+/*
+ * one synthetic raw event: ramps in HG and LG of all ADCs
+ */
+int synthetic_record(void) {
+  uint32_t *w;
+  unsigned i;
+
+  memset(rech, 0, sizeof(rech[0]));
+  rech[0].size = DATASIZE;
+  if((recdata[0] = malloc(DATASIZE)) == NULL)
+    exit(1);
+  w = (uint32_t *)recdata[0];
+  for(i = 0; i < DATASIZE / sizeof(uint32_t); i++)
+    w[i] = (i & 0xfff) | ((~i & 0xfff) << 16);
+  return 1;
+}
+
+double ts_diff(struct timespec *a, struct timespec *b) {
+  return (b->tv_sec - a->tv_sec) + (b->tv_nsec - a->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char **argv) {
+  struct timespec t0, t1, c0, c1, next, now;
+  struct shwr_header sh;
+  struct iovec seg;
+  char *fname = NULL;
+  unsigned long long bytes = 0, datagrams = 0;
+  unsigned size, nfrag;
+  int opt, sock, i, nevents = NEVENTS, rate = RATE, late = 0;
+  long period = 0;
+  double secs, cpu;
+
+  while ((opt = getopt(argc, argv, "d:r:n:m:f:h")) != -1) {
+    switch(opt) {
+    case 'd':
+      if(dest.n >= NDEST_MAX
+	 || parsedest(optarg, DATAPORT, dest.sa + dest.n) < 0) {
+	fprintf(stderr, "Invalid destination %s\n", optarg);
+	exit(1); }
+      dest.n++;
+      break;
+    case 'r':
+      rate = atoi(optarg);
+      break;
+    case 'n':
+      nevents = atoi(optarg);
+      break;
+    case 'm':
+      size = strtoul(optarg, NULL, 0);
+      if(size > PACKETSIZE_MAX || setpacketsize(size) == 0) {
+	fprintf(stderr, "Invalid datagram size %s\n", optarg);
+	exit(1); }
+      break;
+    case 'f':
+      fname = optarg;
+      break;
+    case 'h':
+    default:
+      printhelp(argv[0]);
+      exit(1);
+    }}
+  if(dest.n == 0)
+    parsedest(DEST, DATAPORT, dest.sa + dest.n++);
+  nrec = fname ? read_records(fname) : synthetic_record();
+  if(nrec == 0) {
+    fprintf(stderr, "No records in '%s'\n", fname);
+    exit(1); }
+  if (( sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == -1) {
+    fprintf(stderr, "creating socket failed\n");
+    exit(1); }
+  if(rate > 0)
+    period = 1000000000L / rate;
+
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &c0);
+  next = t0;
+  for(i = 0; i < nevents; i++) {
+    if(period > 0) {
+      if((next.tv_nsec += period) >= 1000000000L) {
+	next.tv_sec += next.tv_nsec / 1000000000L;
+	next.tv_nsec %= 1000000000L; }
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      if(ts_diff(&now, &next) < 0)
+	late++;
+      else
+	while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL)
+	      == EINTR)
+	  ;
+    }
+    sh = rech[i % nrec];
+    sh.id = (i & ID_MASK) | (sh.id & MUON_ID);
+    clock_gettime(CLOCK_REALTIME, &now);
+    sh.ttag_shwr_seconds = now.tv_sec;
+    sh.ttag_shwr_nanosec = now.tv_nsec;
+    seg.iov_base = recdata[i % nrec];
+    seg.iov_len = sh.size;
+    senddata(sock, &dest, &sh, &seg, 1);
+    nfrag = (sh.size + FRAGSIZE(packetsize) - 1) / FRAGSIZE(packetsize);
+    datagrams += dest.n * (1 + nfrag);
+    bytes += dest.n * (sizeof(sh) + nfrag * sizeof(struct frag_header)
+		       + sh.size);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &c1);
+  close(sock);
+
+  secs = ts_diff(&t0, &t1);
+  cpu = ts_diff(&c0, &c1);
+  printf("{\"tool\": \"bench_gen\", \"events\": %d, \"destinations\": %d, "
+	 "\"datagram_size\": %u, \"rate\": %d, \"late\": %d, "
+	 "\"datagrams\": %llu, \"bytes\": %llu, \"seconds\": %.6f, "
+	 "\"events_per_s\": %.1f, \"mbit_per_s\": %.3f, "
+	 "\"cpu_us_per_event\": %.3f}\n",
+	 nevents, dest.n, packetsize, rate, late, datagrams, bytes, secs,
+	 secs > 0 ? nevents / secs : 0, secs > 0 ? bytes * 8e-6 / secs : 0,
+	 nevents > 0 ? cpu * 1e6 / nevents : 0);
+  return 0;
+}
@@ -0,0 +1,273 @@
+/* bench_recv
+   netscope traffic receiver: reassemble events (shwr_header datagram and
+   fragments), count complete and incomplete events, lost ids and missing
+   fragments; latency from send time in ttag_shwr_* (bench_gen events,
+   CLOCK_REALTIME of the sender) or with -u from the time tag of
+   simulated triggers (netscope with READ_EVT_SIM, see read_evt.h)
+   stops after -n events or -t seconds without datagrams,
+   summary printed to stdout as one JSON object
+*/
+
+#define _GNU_SOURCE   /* recvmmsg */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "read_evt.h"
+#include "udp_frame.h"
+
+#define DATAPORT 8888
+#define TIMEOUT 2        /* default idle time to stop [s] */
+#define NSLOT 256        /* events being reassembled, by id % NSLOT */
+#define NBATCH 64        /* datagrams per recvmmsg */
+#define NLAT (1 << 20)   /* max. latencies kept for percentiles */
+#define RCVBUF (4 << 20) /* default socket receive buffer */
+
+struct slot {
+  int used, header;
+  uint32_t id, size, covered;
+  struct shwr_header sh;
+  uint8_t data[FRAME_MAXSIZE];
+};
+
+/* global variables */
+struct slot slots[NSLOT];
+uint32_t lat[NLAT];
+unsigned nlat = 0;
+unsigned long long complete = 0, incomplete = 0, nomiss = 0, missfrag = 0;
+unsigned long long datagrams = 0, bytes = 0, nstats = 0;
+uint32_t idmin = 0xFFFFFFFF, idmax = 0;
+unsigned fragmax = 0;
+FILE *wfp = NULL;
+int ttag = 0;
+
+void printhelp(char *progname) {
+  fprintf(stderr, "Usage: %s [-p <port>] [-g <group>] [-n <events>]"
+	  " [-t <timeout>] [-b <rcvbuf>]\n"
+	  "       [-w <file>] [-u]\n"
+	  "      -p: UDP port (default %d)\n"
+	  "      -g: join multicast group\n"
+	  "      -n: stop after events complete (default on timeout only)\n"
+	  "      -t: stop after timeout s without datagrams (default %d)\n"
+	  "      -b: socket receive buffer (default %d)\n"
+	  "      -w: write complete events to file as records for"
+	  " bench_gen -f\n"
+	  "      -u: latency from UUB time tags (seconds mod 2^28, tics),\n"
+	  "          the sender clock as with READ_EVT_SIM\n",
+	  progname, DATAPORT, TIMEOUT, RCVBUF);
+}
+
+int cmp_u32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return x < y ? -1 : x > y;
+}
+
+/*
+ * account event in slot s, complete or not, and free it
+ */
+void finish(struct slot *s, struct timespec *now) {
+  long long us, ns;
+
+  if(!s->used)
+    return;
+  if(s->header && s->covered >= s->size) {
+    complete++;
+    if(ttag) {
+      ns = (s->sh.ttag_shwr_nanosec & TTAG_NANOSEC_MASK)
+	* (1e9 / TTAG_TICS_HZ);
+      us = (((now->tv_sec - s->sh.ttag_shwr_seconds) & TTAG_SECONDS_MASK)
+	    * 1000000LL) + (now->tv_nsec - ns) / 1000;
+    } else
+      us = (now->tv_sec - (long long)s->sh.ttag_shwr_seconds) * 1000000LL
+	+ (now->tv_nsec - (long long)s->sh.ttag_shwr_nanosec) / 1000;
+    if(nlat < NLAT)
+      lat[nlat++] = us < 0 ? 0 : us;
+    if(wfp && (fwrite(&s->sh, sizeof(s->sh), 1, wfp) != 1
+	       || fwrite(s->data, 1, s->size, wfp) != s->size)) {
+      fprintf(stderr, "Error writing record\n");
+      exit(1); }
+  } else {
+    incomplete++;
+    if(!s->header)
+      nomiss++;
+    else if(fragmax > 0)
+      missfrag += (s->size - s->covered + fragmax - 1) / fragmax;
+  }
+  s->used = 0;
+}
+
+/*
+ * slot of event id, the older event there is finished
+ */
+struct slot *getslot(uint32_t id, struct timespec *now) {
+  struct slot *s = slots + id % NSLOT;
+
+  if(s->used && s->id != id)
+    finish(s, now);
+  if(!s->used) {
+    s->used = 1;
+    s->header = 0;
+    s->id = id;
+    s->size = s->covered = 0; }
+  if((id & ~ID_MASK) == 0) {  /* shower events only */
+    if(id < idmin)
+      idmin = id;
+    if(id > idmax)
+      idmax = id; }
+  return s;
+}
+
+/*
+ * process one datagram
+ */
+void datagram(uint8_t *buf, unsigned len, struct timespec *now) {
+  struct frag_header *fh = (struct frag_header *)buf;
+  struct shwr_header *sh = (struct shwr_header *)buf;
+  struct slot *s;
+
+  datagrams++;
+  bytes += len;
+  if(len >= sizeof(uint32_t)
+     && (fh->id == STATS_MAGIC || fh->id == RATES_MAGIC)) {
+    nstats++;
+    return; }
+  if(len == sizeof(struct shwr_header) && (sh->id & 0x80000000)) {
+    s = getslot(sh->id & ~0x80000000, now);
+    s->sh = *sh;
+    s->sh.id &= ~0x80000000;
+    s->size = sh->size < FRAME_MAXSIZE ? sh->size : FRAME_MAXSIZE;
+    s->header = 1;
+  } else if(len >= sizeof(struct frag_header)
+	    && fh->end > fh->start && fh->end <= FRAME_MAXSIZE
+	    && len - sizeof(struct frag_header) == fh->end - fh->start) {
+    s = getslot(fh->id, now);
+    memcpy(s->data + fh->start, fh + 1, fh->end - fh->start);
+    s->covered += fh->end - fh->start;
+    if(fh->end - fh->start > fragmax)
+      fragmax = fh->end - fh->start;
+  } else
+    return;
+  if(s->header && s->covered >= s->size)
+    finish(s, now);
+}
+
+int main(int argc, char **argv) {
+  static uint8_t bufs[NBATCH][PACKETSIZE_MAX];
+  struct mmsghdr msg[NBATCH];
+  struct iovec iov[NBATCH];
+  struct sockaddr_in sa;
+  struct ip_mreq mreq;
+  struct timeval tv;
+  struct timespec t0, t1, now;
+  char *group = NULL;
+  unsigned long long nevents = 0, lost = 0;
+  int opt, sock, i, n, port = DATAPORT, timeout = TIMEOUT, rcvbuf = RCVBUF;
+  int started = 0;
+  double secs;
+
+  while ((opt = getopt(argc, argv, "p:g:n:t:b:w:uh")) != -1) {
+    switch(opt) {
+    case 'p':
+      port = atoi(optarg);
+      break;
+    case 'g':
+      group = optarg;
+      break;
+    case 'n':
+      nevents = strtoull(optarg, NULL, 0);
+      break;
+    case 't':
+      timeout = atoi(optarg);
+      break;
+    case 'b':
+      rcvbuf = atoi(optarg);
+      break;
+    case 'w':
+      if((wfp = fopen(optarg, "w")) == NULL) {
+	fprintf(stderr, "Cannot open file '%s'\n", optarg);
+	exit(1); }
+      break;
+    case 'u':
+      ttag = 1;
+      break;
+    case 'h':
+    default:
+      printhelp(argv[0]);
+      exit(1);
+    }}
+
+  if ((sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == -1) {
+    fprintf(stderr, "creating socket failed\n");
+    exit(1); }
+  setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+  memset((char *) &sa, 0, sizeof(struct sockaddr_in));
+  sa.sin_family = AF_INET;
+  sa.sin_port = htons(port);
+  sa.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(sock, (struct sockaddr*)&sa, sizeof(struct sockaddr_in)) < 0) {
+    fprintf(stderr, "bind failed\n");
+    exit(1); }
+  if(group != NULL) {
+    if(inet_aton(group, &mreq.imr_multiaddr) == 0) {
+      fprintf(stderr, "Invalid group %s\n", group);
+      exit(1); }
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+    if(setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq,
+		  sizeof(mreq)) < 0) {
+      fprintf(stderr, "cannot join %s: %s\n", group, strerror(errno));
+      exit(1); }}
+  tv.tv_sec = timeout;
+  tv.tv_usec = 0;
+  setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  memset(msg, 0, sizeof(msg));
+  for(i = 0; i < NBATCH; i++) {
+    iov[i].iov_base = bufs[i];
+    iov[i].iov_len = PACKETSIZE_MAX;
+    msg[i].msg_hdr.msg_iov = iov + i;
+    msg[i].msg_hdr.msg_iovlen = 1;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  t1 = t0;
+  while(nevents == 0 || complete < nevents) {
+    if((n = recvmmsg(sock, msg, NBATCH, MSG_WAITFORONE, NULL)) < 0) {
+      if(errno == EINTR)
+	continue;
+      break; }  /* timeout */
+    clock_gettime(CLOCK_REALTIME, &now);
+    if(!started) {
+      clock_gettime(CLOCK_MONOTONIC, &t0);
+      started = 1; }
+    for(i = 0; i < n; i++)
+      datagram(bufs[i], msg[i].msg_len, &now);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+  }
+  clock_gettime(CLOCK_REALTIME, &now);
+  for(i = 0; i < NSLOT; i++)
+    finish(slots + i, &now);
+  close(sock);
+  if(wfp)
+    fclose(wfp);
+
+  if(idmax >= idmin && idmax - idmin + 1 > complete + incomplete)
+    lost = idmax - idmin + 1 - complete - incomplete;
+  qsort(lat, nlat, sizeof(lat[0]), cmp_u32);
+  secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+  printf("{\"tool\": \"bench_recv\", \"events\": %llu, \"incomplete\": %llu, "
+	 "\"no_header\": %llu, \"missing_fragments\": %llu, \"lost\": %llu, "
+	 "\"datagrams\": %llu, \"bytes\": %llu, \"stats\": %llu, "
+	 "\"seconds\": %.6f, \"events_per_s\": %.1f, \"mbit_per_s\": %.3f, "
+	 "\"latency_us\": {\"p50\": %u, \"p90\": %u, \"p99\": %u, "
+	 "\"max\": %u}}\n",
+	 complete, incomplete, nomiss, missfrag, lost, datagrams, bytes,
+	 nstats, secs, secs > 0 ? complete / secs : 0,
+	 secs > 0 ? bytes * 8e-6 / secs : 0,
+	 nlat ? lat[nlat / 2] : 0, nlat ? lat[nlat * 9 / 10] : 0,
+	 nlat ? lat[nlat * 99 / 100] : 0, nlat ? lat[nlat - 1] : 0);
+  return 0;
+}
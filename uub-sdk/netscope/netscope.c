@@ -4,23 +4,25 @@
 
 */
 
-#define VERSION "2020-10-20"
-#define TRIG_EXT
-//#define TRIG_SB
-//#define TRIG_SB_MULTI
-//#define TRIG_COMPAT_SB
+#define VERSION "2026-10-14"
 #define REALTIME
 #define BUFALIGN
 
+#define _GNU_SOURCE   /* sendmmsg */
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <unistd.h>
 #include <sched.h>
 #include <errno.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
 #include <sys/select.h>
+#include <sys/timerfd.h>
+#include <sys/epoll.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -30,79 +32,288 @@
 #include <sys/mman.h>
 #include <ctype.h>
 #include <termios.h>
-
-#include "sde_trigger_defs.h"
-#include "time_tagging.h"
-#include "test_control_defs.h"
-#ifndef TEST_CONTROL_BASE
-  #define TEST_CONTROL_BASE XPAR_TEST_CONTROL_BLOCK_TEST_CONTROL_0_S00_AXI_BASEADDR
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/eventfd.h>
+#include <math.h>
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
 #endif
 
-#define SIG_WAKEUP SIGRTMIN+14
+#include "read_evt.h"
+#include "rt_setup.h"
+#include "shwr_split.h"
+#include "udp_frame.h"
 
 #define SERVER "192.168.31.254"
 #define DATAPORT 8888   //The port on which to send data
-#define CTRLPORT 8887   //The port on which to send data
-#define WAITTIME 10000   /* wait time [ns] between checking data available */
-#define PACKETSIZE 1400  /* plus frag header */
-
-/* from shwr_evt_defs.h */
-#define SHWR_RAW_NCH_MAX 5
-#define SHWR_NCH_MAX (2*SHWR_RAW_NCH_MAX)
-#define SHWR_NSAMPLES 2048
-static unsigned int shwr_addr[SHWR_RAW_NCH_MAX] = {
-  TRIGGER_MEMORY_SHWR0_BASE,
-  TRIGGER_MEMORY_SHWR1_BASE,
-  TRIGGER_MEMORY_SHWR2_BASE,
-  TRIGGER_MEMORY_SHWR3_BASE,
-  TRIGGER_MEMORY_SHWR4_BASE
+#define MCAST_TTL 1      /* default TTL of multicast data */
+#define CTRLPORT 8887   //The port on which to receive commands
+#define NWORKBUF 8       /* work buffers in pipelined mode */
+#define NRETX 16         /* max. sent events kept for retransmission */
+#define STATSPERIOD 1    /* default period of stats datagram [s] */
+#define RATESMIN 10      /* min. period of rates datagram [ms] */
+#define NLOGREC 256      /* records in log ring of each real-time thread */
+#define LOGPERIOD 10000  /* logger thread drains log rings each [us] */
+#define RTPRIO 10        /* default SCHED_FIFO priority of readout */
+
+/* control protocol on CTRLPORT
+   datagram of little endian uint32_t words: command, arguments
+   reply to sender: command | CTRL_REPLY, status (CTRL_OK or CTRL_E*)
+   [, value] */
+#define CTRL_STOP     1   /* stop acquisition and exit */
+#define CTRL_TRIGMASK 2   /* mask: write SHWR_BUF_TRIG_MASK */
+#define CTRL_SBTRIG   3   /* thr0, thr1, thr2, ssd, enab: full bw single bin */
+#define CTRL_COMPATSB 4   /* thr0, thr1, thr2, enab: compatibility single bin */
+#define CTRL_DEST     5   /* IPv4 address (network order), port: data dest. */
+#define CTRL_FRAGSIZE 6   /* max. datagram size receiver accepts;
+			     reply value: datagram size used */
+#define CTRL_NACK     7   /* id, start0, end0, start1, end1, ...: resend
+			     fragments covering byte ranges of event id,
+			     no range: resend whole event with header */
+#define CTRL_MUONMASK 8   /* mask: write MUON_BUF_TRIG_MASK */
+#define CTRL_MUONTRIG 9   /* n (1, 2), thr0, thr1, thr2, ssd, enab:
+			     muon trigger n */
+#define CTRL_ADDDEST 10   /* IPv4 address (network order), port: add data
+			     dest. (multicast group too) to the current ones */
+#define CTRL_DELDEST 11   /* IPv4 address (network order), port: remove it */
+#define CTRL_RATES   12   /* period [ms]: send rates datagram each period,
+			     0 stops it; reply value: period used */
+#define CTRL_SCALER  13   /* n (0 - 2: A - C), thr0, thr1, thr2, enab:
+			     compatibility scaler n */
+#define CTRL_AVERAGE 14   /* n, k: send sums of blocks of n traces
+			     (SHWR_FMT_AVERAGE, 0 stops), each k-th event
+			     as well (0 none) */
+#define CTRL_CREDIT  15   /* events, bytes, policy (CREDIT_*): flow control,
+			     set remaining credit (CREDIT_NOLIMIT: not
+			     limited, both: flow control off) */
+#define CTRL_REPLY  0x80000000
+#define CTRL_OK       0
+#define CTRL_EINVAL   1   /* unknown command or wrong number of arguments */
+#define CTRL_ENOENT   2   /* event not kept for retransmission any more
+			     or destination not present */
+#define CTRL_MAXARGS  33
+
+#define WBUFSIZE (MUONSIZE > DATASIZE ? MUONSIZE : DATASIZE)
+
+/* flow control: datagrams of events are sent while both event and byte
+   credit are positive, each event and averaged record sent takes one
+   event and its payload size, retransmissions none; out of credit events
+   wait in work buffers (pipelined), then by policy */
+#define CREDIT_NOLIMIT 0xFFFFFFFF
+#define CREDIT_HOLD   0   /* do not release shower buffers, the FPGA stops
+			     accepting triggers when all are full */
+#define CREDIT_DROP   1   /* release them unsent, counted in stats */
+
+/* stats datagram, sent each period to data destination
+   STATS_MAGIC (udp_frame.h), counters and histograms since the previous
+   one, all little endian uint32_t
+   log2 histograms: bucket 0 for value 0, bucket b for [2^(b-1), 2^b),
+   the last bucket includes all above; linear histograms: bucket = value */
+#define NBUCKET 24
+#define HIST_LATENCY  0  /* log2: SHWR_BUF_LATENCY at readout [FPGA ticks] */
+#define HIST_LATENCY0 1  /* log2: SHWR_BUF_LATENCY0 (14120420 only) */
+#define HIST_LATENCY1 2  /* log2: SHWR_BUF_LATENCY1 (14120420 only) */
+#define HIST_COPY     3  /* log2: copy from shower memory [us] */
+#define HIST_SEND     4  /* log2: encode and send [us] */
+#define HIST_NFULL    5  /* linear: full shower buffers at readout */
+#define HIST_RING     6  /* linear: filled work buffers at readout */
+#define NHIST 7
+struct stats {
+  uint32_t magic;      /* STATS_MAGIC */
+  uint32_t interval;   /* time since previous stats [ms] */
+  uint32_t events;     /* events read out */
+  uint32_t drops;      /* triggers lost, by gaps in SHWR_EVT_ID */
+  uint32_t fullbuf;    /* readouts with all shower buffers full */
+  uint32_t ringfull;   /* times all work buffers became filled */
+  uint32_t readerr;    /* read evt errors */
+  uint32_t nacks;      /* CTRL_NACK commands */
+  uint32_t muons;      /* muon buffers read out */
+  uint32_t nocredit;   /* times events became held for credit */
+  uint32_t creditdrops;  /* events released unsent for lack of credit */
+  uint32_t senderr;    /* events not sent to a destination on error */
+  uint32_t hist[NHIST][NBUCKET];
 };
 
-struct read_evt_global {
-  uint32_t id_counter;
-  uint32_t volatile *shwr_pt[SHWR_RAW_NCH_MAX];
-  int shwr_mem_size;
+/* rates datagram, sent each rates period to data destination
+   trigger rate and scaler registers as read, all little endian uint32_t */
+struct rates {
+  uint32_t magic;          /* RATES_MAGIC (udp_frame.h) */
+  uint32_t seconds;        /* TTAG_PPS_SECONDS at sampling */
+  uint32_t interval;       /* time since previous rates [ms] */
+  uint32_t trig_rates;     /* COMPATIBILITY_TRIG_RATES */
+  uint32_t delayed_rates;  /* COMPATIBILITY_DELAYED_RATES */
+  uint32_t scaler[3];      /* COMPATIBILITY_SCALER_A - C_COUNT */
+};
 
-  uint32_t volatile *regs;
-  uint32_t volatile *tt_regs;
-  uint32_t volatile *tstctl_regs;
-  int regs_size;
+/* remaining credit of flow control, LLONG_MAX if not limited,
+   set by the main thread, taken by the sending one under lock */
+struct credit {
+  pthread_mutex_t lock;
+  pthread_cond_t granted;  /* signalled on CTRL_CREDIT and stop */
+  int on;          /* flow control by CTRL_CREDIT or -C */
+  int policy;      /* CREDIT_HOLD or CREDIT_DROP */
+  int wait;        /* sender thread waits for credit (pipelined) */
+  int stop;        /* sender stops, do not wait any more */
+  long long events, bytes;
+};
 
-  sigset_t sigset; /*used to wake the process periodically */
+/* ring of work buffers for pipelined mode:
+   readout fills slot head % NWORKBUF, sender thread sends slot tail % NWORKBUF
+   head and tail are accessed by __atomic builtins */
+struct workring {
+  struct shwr_header sh[NWORKBUF];
+  long long duration[NWORKBUF];
+  unsigned head, tail;
+  sem_t filled;    /* posted by readout for each filled slot */
+  int spacefd;     /* eventfd written by sender for each freed slot */
+  int sock;
 };
 
-struct shwr_header {
-  uint32_t id;
-  uint32_t shwr_buf_status, shwr_buf_start, shwr_buf_trig_id;
-  uint32_t ttag_shwr_seconds, ttag_shwr_nanosec;
-  uint32_t rd;
+/* sent events kept for retransmission in slot id % depth,
+   a slot is invalid while being refilled, lock is held during resend */
+struct retxring {
+  pthread_mutex_t lock;
+  unsigned depth;    /* 0: retransmission disabled */
+  int valid[NRETX];
+  struct shwr_header sh[NRETX];
+  uint8_t data[NRETX][WBUFSIZE];
 };
 
-struct frag_header {
-  uint32_t id;
-  uint16_t start;
-  uint16_t end;
+/* log record; fmt NULL for sent event (sh, duration)
+   otherwise printf format with LOGNARG uint32_t arguments,
+   followed by strerror(err) if err != 0 */
+#define LOGNARG 4
+struct logrec {
+  const char *fmt;
+  int err;
+  uint32_t arg[LOGNARG];
+  struct shwr_header sh;
+  long long duration;
 };
 
-#define PAGESIZE (sysconf(_SC_PAGESIZE))
-#define DATASIZE (sizeof(uint32_t) * SHWR_NSAMPLES * SHWR_RAW_NCH_MAX)
-#define WBUFSIZE (sizeof(struct frag_header) + DATASIZE)
+/* single producer, single consumer ring of log records
+   head and tail are accessed by __atomic builtins */
+struct logring {
+  struct logrec rec[NLOGREC];
+  unsigned head, tail;
+  unsigned dropped;   /* records lost on full ring */
+};
 
 /* global variables */
-static struct read_evt_global gl;
-static struct shwr_header sh;
-/* make workbuf aligned on 4B but not on 8B */
-uint8_t _workbuf[WBUFSIZE + 8];
+static struct workring ring;
+static struct credit credit = {
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+  .granted = PTHREAD_COND_INITIALIZER,
+  .policy = CREDIT_HOLD,
+  .events = LLONG_MAX,
+  .bytes = LLONG_MAX
+};
+static struct stats stats;  /* updated by __atomic builtins */
+static struct logring logring[2];  /* readout and sender thread */
+static __thread struct logring *mylog;  /* log ring of current thread */
+int verbosity = 1;   /* 0: errors and commands only, 1: also sent events */
+unsigned lograte = 0;  /* max. sent events logged per second, 0: all */
+int logstop = 0;     /* tell logger thread to drain rings and exit */
+int rtprio = RTPRIO; /* sender thread runs one step below */
+int rtcpu = -1;      /* cpu of readout in real-time mode, -1 if not pinned */
+static struct retxring retx = {
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+  .depth = NRETX
+};
+/* make work buffers aligned on 4B but not on 8B (WBUFSIZE is 8*n) */
+uint8_t _workbuf[NWORKBUF * WBUFSIZE + 8];
 #ifdef BUFALIGN
   #define workbuf ((uint8_t*)((((uintptr_t)_workbuf) & ~7) + 4))
 #else
   #define workbuf _workbuf
 #endif
-#define databuf (workbuf + sizeof(struct frag_header))
-#define endbuf (workbuf + WBUFSIZE)
+#define wbuf(slot) (workbuf + (slot) * WBUFSIZE)
+uint8_t txbuf[DATASIZE];  /* encoded payload of the event being sent */
+/* HG0, LG0, HG1, ... traces of the event being encoded */
+uint16_t traces[SHWR_NCH_MAX][SHWR_NSAMPLES];
+/* data destinations, all get each datagram; can be changed by CTRL_DEST,
+   CTRL_ADDDEST and CTRL_DELDEST while sender runs */
+struct destlist dest;
+pthread_mutex_t destlock = PTHREAD_MUTEX_INITIALIZER;
+int format = SHWR_FMT_RAW;
+int compress = 0;   /* try SHWR_FMT_DELTA, fall back to format */
+int features = 0;   /* send SHWR_FMT_FEATURE instead of traces */
+unsigned traceevery = 0;  /* in features mode send trace of each n-th event */
+unsigned pedstart = 0, pedend = SHWR_NSAMPLES;  /* pedestal window */
+int ratesfd = -1;   /* timer of rates datagram, set by CTRL_RATES */
+/* averaging mode: n | k << AVG_KSHIFT (see CTRL_AVERAGE), 0 off,
+   read by sender by __atomic builtins */
+#define AVG_KSHIFT 16
+uint32_t avgmode = 0;
+/* sums and sums of squares of traces of the current block */
+uint32_t avgsum[SHWR_NCH_MAX][SHWR_NSAMPLES];
+uint32_t avgsumsq[SHWR_NCH_MAX][SHWR_NSAMPLES];
 
 /* functions */
 
+void printhelp(char *progname) {
+  fprintf(stderr, "Usage: %s [-a <cpu>] [-P <prio>] [-p | -z] [-c]"
+	  " [-f <format>]\n"
+	  "       [-F <n>] [-A <n[:k]>] [-w <start:end>] [-m <size|iface>]"
+	  " [-C <policy>]\n"
+	  "       [-r <depth>]"
+	  " [-s <period>] [-R <period>] [-t <trigger>] [-u <uio_device>]\n"
+	  "       [-M] [-d <addr[:port]>] [-T <ttl>] [-v <level>] [-l <rate>]"
+	  " [-h] [-V]\n"
+	  "      -a: real-time mode: pin readout to cpu, lock memory and\n"
+	  "          prefault stack and buffers\n"
+	  "      -P: SCHED_FIFO priority of readout (default %d)\n"
+	  "      -c: compress traces losslessly (delta + bit packing) when\n"
+	  "          shorter than format\n"
+	  "      -f: payload format: raw (default) or packed (12-bit samples)\n"
+	  "      -F: send per channel pedestal mean and rms, peak and its\n"
+	  "          position instead of traces, the trace of each n-th event\n"
+	  "          (0: none)\n"
+	  "      -A: average: send sums and sums of squares of each block of\n"
+	  "          n (1 - %d) traces instead of them, each k-th event as\n"
+	  "          well (default 0: none)\n"
+	  "      -w: pedestal window [start, end) in samples (default %d:%d)\n"
+	  "      -m: datagram size (%d - %d, default %d), or interface name\n"
+	  "          to fit its MTU; the receiver may lower it by CTRL_FRAGSIZE\n"
+	  "      -r: keep last depth (0 - %d, default %d) sent events to resend\n"
+	  "          on CTRL_NACK, 0 disables it\n"
+	  "      -s: period of stats datagram to data destination\n"
+	  "          (default %d s), 0 disables it\n"
+	  "      -R: period of rates datagram (trigger rates and scalers) to\n"
+	  "          data destination [ms] (default 0: none, min. %d), see\n"
+	  "          CTRL_RATES and CTRL_SCALER\n"
+	  "      -p: pipelined mode, read out all full buffers into %d work\n"
+	  "          buffers and send them from a separate thread\n"
+	  "      -z: zero-copy mode, send directly from shower memory,\n"
+	  "          release buffer after send\n"
+	  "      -C: flow control: send events only as credit is granted by\n"
+	  "          CTRL_CREDIT, out of credit (and work buffers) hold\n"
+	  "          shower buffers, pausing triggers, or drop events\n"
+	  "          (policy hold or drop)\n"
+	  "      -t: initial trigger: ext (default), sb, sbmulti or compatsb\n"
+	  "          (single bin thresholds 1000), see CTRL_* to change it\n"
+	  "      -d: data destination (default %s:%d), up to %d times for more\n"
+	  "          destinations, an IP multicast group for any number of\n"
+	  "          receivers sent once\n"
+	  "      -T: TTL of multicast data (default %d)\n"
+	  "      -u: wait for shower interrupt on UIO device (e.g. /dev/uio0)\n"
+	  "          instead of polling every %d ns\n"
+	  "      -M: read out and send muon buffers too (polled), set muon\n"
+	  "          trigger by CTRL_MUONMASK and CTRL_MUONTRIG\n"
+	  "      -v: log level: 0 errors and commands, 1 (default) also sent\n"
+	  "          events\n"
+	  "      -l: log at most rate sent events per second (default all)\n"
+	  "      -V: print version and exit\n"
+	  "      -h: print help and exit\n"
+	  "  acquisition stops on CTRL_STOP command to UDP port %d\n",
+	  progname, RTPRIO, AVERAGE_MAX, 0, SHWR_NSAMPLES,
+	  PACKETSIZE_MIN, PACKETSIZE_MAX, PACKETSIZE,
+	  NRETX, NRETX, STATSPERIOD, RATESMIN, NWORKBUF, SERVER, DATAPORT,
+	  NDEST_MAX, MCAST_TTL, WAITTIME, CTRLPORT);
+}
+
 void printver() {
   fputs("netscope v" VERSION
 #ifdef BUFALIGN
@@ -111,42 +322,59 @@ void printver() {
 #ifdef REALTIME
 	" REALTIME"
 #endif
-#if defined(TRIG_EXT)
-	" TRIG_EXT"
-#elif defined(TRIG_SB)
-	" TRIG_SB"
-#elif defined(TRIG_SB_MULTI)
-	" TRIG_SB_MULTI"
-#elif defined(TRIG_COMPAT_SB)
-	" TRIG_COMPAT_SB"
+#ifdef __ARM_NEON__
+	" NEON"
 #endif
 	"\n", stderr);
 }
 
 /*
- * open socket for sending data
- * construct server address in sa
+ * open socket for sending data, multicast with ttl
  */
-int opensock(struct sockaddr_in* sa) {
+int opensock(int ttl) {
+  unsigned char mttl = ttl;
   int sock;
  
   if (( sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == -1) {
     fprintf(stderr, "creating socket failed\n");
     exit(1); }
-    
-  memset((char *) sa, 0, sizeof(struct sockaddr_in));
-  sa->sin_family = AF_INET;
-  sa->sin_port = htons(DATAPORT);
-
-  if (inet_aton(SERVER, &(sa->sin_addr)) == 0) {
-    fprintf(stderr, "inet_aton failed");
-    exit(1); }
+  if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_TTL, &mttl, sizeof(mttl)) < 0)
+    fprintf(stderr, "cannot set multicast TTL: %s\n", strerror(errno));
 
   return(sock);
 }
 
 /*
- * control socket: wait for any packet to stop 
+ * add (add) or remove destination addr (network order), port
+ * return CTRL_OK, CTRL_EINVAL if list full, CTRL_ENOENT if not present
+ */
+uint32_t setdest(uint32_t addr, uint32_t port, int add) {
+  uint32_t status = add ? CTRL_EINVAL : CTRL_ENOENT;
+  int i;
+
+  pthread_mutex_lock(&destlock);
+  for(i = 0; i < dest.n; i++)
+    if(dest.sa[i].sin_addr.s_addr == addr
+       && dest.sa[i].sin_port == htons(port))
+      break;
+  if(add && i < dest.n)
+    status = CTRL_OK;  /* already there */
+  else if(add && dest.n < NDEST_MAX) {
+    memset((char *) &dest.sa[i], 0, sizeof(struct sockaddr_in));
+    dest.sa[i].sin_family = AF_INET;
+    dest.sa[i].sin_addr.s_addr = addr;
+    dest.sa[i].sin_port = htons(port);
+    dest.n++;
+    status = CTRL_OK;
+  } else if(!add && i < dest.n) {
+    dest.sa[i] = dest.sa[--dest.n];
+    status = CTRL_OK; }
+  pthread_mutex_unlock(&destlock);
+  return status;
+}
+
+/*
+ * control socket: receive commands (CTRL_*)
  */
 int opencontrolsock() {
   struct timeval read_timeout;
@@ -176,227 +404,1191 @@ int opencontrolsock() {
 
 
 /*
- * send data: shwr_header and databuf in pieces
+ * get free record in log ring of current thread, NULL if full
+ * the record is passed to logger by log_commit()
  */
-void senddata(int sock, struct sockaddr_in* sa) {
-  unsigned psize;
-  uint8_t * start;
-  uint8_t * end;
-  uint32_t id = sh.id;
-  struct frag_header *fh;
-  
-  /* send header */
-  psize = sizeof(struct shwr_header);
-  sh.id |= 0x80000000;
-  if(sendto(sock, (uint8_t *) &sh, psize, 0,
-	    (struct sockaddr*)sa, sizeof(struct sockaddr_in)) != psize) {
-    fprintf(stderr, "senddata header failed\n");
+struct logrec *log_begin() {
+  unsigned head = mylog->head;
+
+  if(head - __atomic_load_n(&mylog->tail, __ATOMIC_ACQUIRE) >= NLOGREC) {
+    __atomic_fetch_add(&mylog->dropped, 1, __ATOMIC_RELAXED);
+    return NULL; }
+  return &mylog->rec[head % NLOGREC];
+}
+
+void log_commit() {
+  __atomic_store_n(&mylog->head, mylog->head + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * log message fmt with arguments (up to LOGNARG uint32_t) and errno err
+ * never blocks, formatted by logger thread
+ */
+#define logmsg(err, fmt, ...) \
+  logmsg_arg(err, fmt, (uint32_t [LOGNARG]){__VA_ARGS__})
+void logmsg_arg(int err, const char *fmt, const uint32_t *arg) {
+  struct logrec *rec;
+
+  if((rec = log_begin()) == NULL)
+    return;
+  rec->fmt = fmt;
+  rec->err = err;
+  memcpy(rec->arg, arg, sizeof(rec->arg));
+  log_commit();
+}
+
+/*
+ * log sent event
+ */
+void logsent(struct shwr_header *sh, long long duration) {
+  struct logrec *rec;
+
+  if(verbosity < 1 || (rec = log_begin()) == NULL)
+    return;
+  rec->fmt = NULL;
+  rec->sh = *sh;
+  rec->duration = duration;
+  log_commit();
+}
+
+void printsent(struct shwr_header *sh, long long duration) {
+  fprintf(stderr, "sent id %08x, rd %d, time %9d.%09d [s.tics], evt %1x"
+	  ", duration %lld [us], fmt %d, size %u\n",
+	  sh->id, sh->rd, sh->ttag_shwr_seconds,
+	  sh->ttag_shwr_nanosec & TTAG_NANOSEC_MASK,
+	  sh->ttag_shwr_nanosec >> TTAG_EVTCTR_SHIFT,
+	  duration, sh->format, sh->size);
+}
+
+/*
+ * logger thread: format records from log rings to stderr,
+ * at most lograte sent events per second
+ */
+void *logger(void *arg) {
+  struct logrec *rec;
+  struct logring *lr;
+  unsigned i, tail, dropped, nsent = 0, skipped = 0;
+  long long now, window = time_us();
+  int stop;
+
+  do {
+    stop = __atomic_load_n(&logstop, __ATOMIC_ACQUIRE);
+    if((now = time_us()) - window >= 1000000) {
+      if(skipped > 0)
+	fprintf(stderr, "%u sent events not logged\n", skipped);
+      window = now;
+      nsent = skipped = 0; }
+    for(i = 0; i < sizeof(logring) / sizeof(logring[0]); i++) {
+      lr = logring + i;
+      while((tail = lr->tail) != __atomic_load_n(&lr->head, __ATOMIC_ACQUIRE)) {
+	rec = &lr->rec[tail % NLOGREC];
+	if(rec->fmt != NULL) {
+	  fprintf(stderr, rec->fmt,
+		  rec->arg[0], rec->arg[1], rec->arg[2], rec->arg[3]);
+	  if(rec->err != 0)
+	    fprintf(stderr, ": %s", strerror(rec->err));
+	  fputc('\n', stderr);
+	} else if(lograte == 0 || nsent < lograte) {
+	  printsent(&rec->sh, rec->duration);
+	  nsent++;
+	} else
+	  skipped++;
+	__atomic_store_n(&lr->tail, tail + 1, __ATOMIC_RELEASE);
+      }
+      if((dropped = __atomic_exchange_n(&lr->dropped, 0, __ATOMIC_RELAXED)))
+	fprintf(stderr, "%u log records lost\n", dropped);
+    }
+    if(!stop)
+      usleep(LOGPERIOD);
+  } while(!stop);
+  if(skipped > 0)
+    fprintf(stderr, "%u sent events not logged\n", skipped);
+  return NULL;
+}
+
+/*
+ * start logger thread at normal priority, log of current thread to ring 0
+ */
+void logger_start(pthread_t *thread) {
+  pthread_attr_t attr;
+  struct sched_param sched_p;
+  cpu_set_t cpus;
+  int i, ncpu, res;
+
+  mylog = &logring[0];
+  pthread_attr_init(&attr);
+  sched_p.sched_priority = 0;
+  pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+  pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+  pthread_attr_setschedparam(&attr, &sched_p);
+  /* keep off the cpu of pinned readout if there is another one */
+  if(rtcpu >= 0 && (ncpu = sysconf(_SC_NPROCESSORS_ONLN)) > 1) {
+    CPU_ZERO(&cpus);
+    for(i = 0; i < ncpu; i++)
+      if(i != rtcpu)
+	CPU_SET(i, &cpus);
+    pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus); }
+  if((res = pthread_create(thread, &attr, logger, NULL)) != 0) {
+    fprintf(stderr, "Cannot create logger thread: %s\n", strerror(res));
     exit(1); }
+  pthread_attr_destroy(&attr);
+}
+
+/*
+ * let logger thread drain all records and wait for it
+ */
+void logger_stop(pthread_t thread) {
+  __atomic_store_n(&logstop, 1, __ATOMIC_RELEASE);
+  pthread_join(thread, NULL);
+}
 
-  for(start = end = workbuf; end < endbuf;
-      start = end - sizeof(struct frag_header)) {
-    if ((end = start + PACKETSIZE) > endbuf)
-      end = endbuf;
+/*
+ * add value to log2 histogram h
+ */
+void stats_hist(int h, uint32_t value) {
+  unsigned b = value ? 32 - __builtin_clz(value) : 0;
 
-    fh = (struct frag_header *)start;
-    fh->id = id;
-    fh->start = start - workbuf;
-    fh->end = end - databuf;
+  if(b >= NBUCKET)
+    b = NBUCKET - 1;
+  __atomic_fetch_add(&stats.hist[h][b], 1, __ATOMIC_RELAXED);
+}
 
-    psize = end - start;
-    if (sendto(sock, start, psize, 0,
-	       (struct sockaddr*)sa, sizeof(struct sockaddr_in)) != psize) {
-      fprintf(stderr, "senddata failed");
-      exit(1); }
-  }
+/*
+ * add value to linear histogram h
+ */
+void stats_lin(int h, uint32_t value) {
+  if(value >= NBUCKET)
+    value = NBUCKET - 1;
+  __atomic_fetch_add(&stats.hist[h][value], 1, __ATOMIC_RELAXED);
 }
 
+#define stats_count(counter) \
+  __atomic_fetch_add(&stats.counter, 1, __ATOMIC_RELAXED)
+
 /*
- * check if there is an incoming UDP datagram
+ * account event with header sh, while its shower buffer is not released
  */
-#define BUFSIZE 1
-int controlrecv(int sock){
-  /* struct sockaddr src_addr; */
-  /* socklen_t addrlen; */
-  char buf[BUFSIZE];
-  ssize_t msglen;
+void stats_evt(struct shwr_header *sh) {
+  static int previd = -1;
+  unsigned evtid, nfull;
 
-  msglen = recvfrom(sock, (void *)buf, BUFSIZE, MSG_DONTWAIT, NULL, NULL);
-  /* msglen = recvfrom(sock, (void *)buf, BUFSIZE, MSG_DONTWAIT, */
-  /* 		  &src_addr, &addrlen); */
-  return msglen;
+  stats_count(events);
+  evtid = (sh->shwr_buf_trig_id >> SHWR_EVT_ID_SHIFT) & SHWR_EVT_ID_MASK;
+  if(previd >= 0)
+    __atomic_fetch_add(&stats.drops, (evtid - previd - 1) & SHWR_EVT_ID_MASK,
+		       __ATOMIC_RELAXED);
+  previd = evtid;
+  nfull = (sh->shwr_buf_status >> SHWR_BUF_NFULL_SHIFT) & SHWR_BUF_NFULL_MASK;
+  stats_lin(HIST_NFULL, nfull);
+  if(nfull >= SHWR_MEM_NBUF)
+    stats_count(fullbuf);
+  stats_hist(HIST_LATENCY, gl.regs[SHWR_BUF_LATENCY_ADDR]);
+#ifdef SHWR_BUF_LATENCY0_ADDR
+  stats_hist(HIST_LATENCY0, gl.regs[SHWR_BUF_LATENCY0_ADDR]);
+  stats_hist(HIST_LATENCY1, gl.regs[SHWR_BUF_LATENCY1_ADDR]);
+#endif
 }
 
 /*
- *  round up <n> to multiple of <multiple>
+ * send stats accumulated since the previous call to dl and reset them
  */
-unsigned roundup(unsigned n, unsigned multiple) {
-  return ((n + multiple-1) / multiple) * multiple;
+void stats_send(int sock, struct destlist *dl) {
+  static long long prev = 0;
+  struct stats st;
+  uint32_t *src = (uint32_t *)&stats, *dst = (uint32_t *)&st;
+  long long now = time_us();
+  unsigned i;
+
+  for(i = 0; i < sizeof(st) / sizeof(uint32_t); i++)
+    dst[i] = __atomic_exchange_n(src + i, 0, __ATOMIC_RELAXED);
+  st.magic = STATS_MAGIC;
+  st.interval = prev ? (now - prev) / 1000 : 0;
+  prev = now;
+  for(i = 0; i < dl->n; i++)
+    if(sendto(sock, &st, sizeof(st), MSG_DONTWAIT,
+	      (struct sockaddr *)(dl->sa + i), sizeof(struct sockaddr_in)) < 0)
+      logmsg(errno, "stats send failed", 0);
 }
 
 /*
- * mmap regs and shwr_pt
+ * send trigger rate and scaler registers to dl
  */
-void read_evt_init() {
-  int i, fd, size;
-  void * pt;
-  struct sigevent sev;
-  timer_t t_alarm;
+void rates_send(int sock, struct destlist *dl) {
+  static long long prev = 0;
+  struct rates rt;
+  long long now = time_us();
+  unsigned i;
+
+  rt.magic = RATES_MAGIC;
+  rt.seconds = gl.tt_regs[TTAG_PPS_SECONDS_ADDR] & TTAG_SECONDS_MASK;
+  rt.interval = prev ? (now - prev) / 1000 : 0;
+  prev = now;
+  rt.trig_rates = gl.regs[COMPATIBILITY_TRIG_RATES_ADDR];
+  rt.delayed_rates = gl.regs[COMPATIBILITY_DELAYED_RATES_ADDR];
+  rt.scaler[0] = gl.regs[COMPATIBILITY_SCALER_A_COUNT_ADDR];
+  rt.scaler[1] = gl.regs[COMPATIBILITY_SCALER_B_COUNT_ADDR];
+  rt.scaler[2] = gl.regs[COMPATIBILITY_SCALER_C_COUNT_ADDR];
+  for(i = 0; i < dl->n; i++)
+    if(sendto(sock, &rt, sizeof(rt), MSG_DONTWAIT,
+	      (struct sockaddr *)(dl->sa + i), sizeof(struct sockaddr_in)) < 0)
+      logmsg(errno, "rates send failed", 0);
+}
+
+/*
+ * arm periodic timer fd to period [ms], 0 disarms it
+ */
+int timer_set(int fd, unsigned period) {
   struct itimerspec ts;
 
-  if((fd = open("/dev/mem",O_RDWR)) < 0 ) {
-    fprintf(stderr, "Error opening /dev/mem\n");
-    exit(1); }
+  ts.it_interval.tv_sec = ts.it_value.tv_sec = period / 1000;
+  ts.it_interval.tv_nsec = ts.it_value.tv_nsec = period % 1000 * 1000000;
+  return timerfd_settime(fd, 0, &ts, NULL);
+}
 
-  size = roundup(256*sizeof(uint32_t), PAGESIZE);
-  gl.regs_size = size;
-  pt = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
-	    SDE_TRIGGER_BASE);
-  if(pt == MAP_FAILED) {
-    fprintf(stderr, "Error mapping regs\n");
-    exit(1); }
-  gl.regs = (uint32_t *)pt;
+/*
+ * pack trace to 12-bit samples
+ */
+void pack12(const uint16_t *y, uint8_t *out) {
+  unsigned i;
+  uint16_t a, b;
 
-  pt = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
-	    TIME_TAGGING_BASE);
-  if(pt == MAP_FAILED) {
-    fprintf(stderr, "Error mapping tt_regs\n");
-    exit(1); }
-  gl.tt_regs = (uint32_t *)pt;
+  for(i = 0; i < SHWR_NSAMPLES; i += 2) {
+    a = y[i];
+    b = y[i + 1];
+    *out++ = a;
+    *out++ = (a >> 8) | (b << 4);
+    *out++ = b >> 4;
+  }
+}
 
-  pt = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
-	    TEST_CONTROL_BASE);
-  if(pt == MAP_FAILED) {
-    fprintf(stderr, "Error mapping tstctl_regs\n");
-    exit(1); }
-  gl.tstctl_regs = (uint32_t *)pt;
-
-  size = roundup(SHWR_MEM_DEPTH * SHWR_MEM_NBUF, PAGESIZE);
-  gl.shwr_mem_size = size;
-  for( i = 0; i < SHWR_RAW_NCH_MAX; i++ ) {
-    pt = mmap(NULL,size, PROT_READ, MAP_SHARED, fd, shwr_addr[i]);
-    if(pt == MAP_FAILED) {
-      fprintf(stderr, "Error mapping shower buf %d\n", i);
-      exit(1); }
-    gl.shwr_pt[i] = (uint32_t *) pt;
+/*
+ * code trace into out in SHWR_FMT_DELTA
+ * return number of bytes written, 0 if it would exceed limit
+ */
+unsigned delta_encode(const uint16_t *y, uint8_t *out, unsigned limit) {
+  uint32_t z[DELTA_BLOCK], any;
+  int32_t d, prev;
+  unsigned blk, k, w, pos;
+  uint64_t acc;
+  int nacc;
+
+  prev = 0;
+  for(blk = pos = 0; blk < SHWR_NSAMPLES; blk += DELTA_BLOCK) {
+    for(k = any = 0; k < DELTA_BLOCK; k++) {
+      d = y[blk + k];
+      z[k] = ((uint32_t)(d - prev) << 1) ^ (uint32_t)((d - prev) >> 31);
+      any |= z[k];
+      prev = d;
+    }
+    w = any ? 32 - __builtin_clz(any) : 0;
+    if(pos + 1 + DELTA_BLOCK*w/8 > limit)
+      return 0;
+    out[pos++] = w;
+    for(k = 0, acc = 0, nacc = 0; k < DELTA_BLOCK; k++) {
+      acc |= (uint64_t)z[k] << nacc;
+      for(nacc += w; nacc >= 8; nacc -= 8, acc >>= 8)
+	out[pos++] = acc;
+    }
   }
-  close(fd);
+  return pos;
+}
 
-  /*setting periodical process wakeup to check if there are event.
-    It is ugly, but for now, it would work in this whay, until
-    we figure a what to implement interruptions through the kernel */
+/*
+ * sum and sum of squares of n samples of trace y
+ */
+void trace_sums(const uint16_t *y, unsigned n,
+		uint32_t *sum, uint64_t *sumsq) {
+  unsigned i = 0;
+#ifdef __ARM_NEON__
+  uint16x8_t v;
+  uint32x4_t s = vdupq_n_u32(0);
+  uint64x2_t s2 = vdupq_n_u64(0);
 
-  /*signal of alarm handler - it is going to be just blocked
-    to be used with sigtimedwait system call.
-  */
-  if(sigemptyset(&gl.sigset) != 0){
-    fprintf(stderr, "error while trying to set signals ... 1 \n");
-    exit(1);
+  for(; i + 8 <= n; i += 8) {
+    v = vld1q_u16(y + i);
+    s = vpadalq_u16(s, v);
+    s2 = vpadalq_u32(s2, vmull_u16(vget_low_u16(v), vget_low_u16(v)));
+    s2 = vpadalq_u32(s2, vmull_u16(vget_high_u16(v), vget_high_u16(v)));
   }
-  if(sigaddset(&gl.sigset, SIG_WAKEUP) != 0){
-    fprintf(stderr, "error while trying to set signals ... 2\n");
-    exit(1);
+  *sum = vgetq_lane_u32(s, 0) + vgetq_lane_u32(s, 1)
+    + vgetq_lane_u32(s, 2) + vgetq_lane_u32(s, 3);
+  *sumsq = vgetq_lane_u64(s2, 0) + vgetq_lane_u64(s2, 1);
+#else
+  *sum = 0;
+  *sumsq = 0;
+#endif
+  for(; i < n; i++) {
+    *sum += y[i];
+    *sumsq += (uint32_t)y[i] * y[i]; }
+}
+
+/*
+ * max. sample of trace y
+ */
+uint16_t trace_max(const uint16_t *y) {
+  unsigned i;
+  uint16_t max;
+#ifdef __ARM_NEON__
+  uint16x8_t m = vdupq_n_u16(0);
+  uint16x4_t r;
+
+  for(i = 0; i < SHWR_NSAMPLES; i += 8)
+    m = vmaxq_u16(m, vld1q_u16(y + i));
+  r = vpmax_u16(vget_low_u16(m), vget_high_u16(m));
+  r = vpmax_u16(r, r);
+  r = vpmax_u16(r, r);
+  max = vget_lane_u16(r, 0);
+#else
+  for(i = max = 0; i < SHWR_NSAMPLES; i++)
+    if(y[i] > max)
+      max = y[i];
+#endif
+  return max;
+}
+
+/*
+ * compute SHWR_FMT_FEATURE payload from traces into out
+ * return its size
+ */
+unsigned feature_encode(uint16_t traces[][SHWR_NSAMPLES], uint8_t *out) {
+  struct feature_header *fh = (struct feature_header *)out;
+  struct feature *f = (struct feature *)(fh + 1);
+  unsigned ch, i, n = pedend - pedstart;
+  uint32_t sum;
+  uint64_t sumsq;
+  double mean, var;
+
+  fh->pedstart = pedstart;
+  fh->pedend = pedend;
+  for(ch = 0; ch < SHWR_NCH_MAX; ch++, f++) {
+    trace_sums(traces[ch] + pedstart, n, &sum, &sumsq);
+    mean = (double)sum / n;
+    var = (sumsq - mean * sum) / (n - 1);
+    f->mean = mean;
+    f->rms = var > 0 ? sqrt(var) : 0;
+    f->peak = trace_max(traces[ch]);
+    for(i = 0; traces[ch][i] != f->peak; i++)
+      ;
+    f->peakpos = i;
   }
-  if(sigprocmask(SIG_BLOCK, &gl.sigset, NULL) != 0){
-    fprintf(stderr, "error while trying to set signals ... 3 \n");
-    exit(1);
+  return FEATURESIZE;
+}
+
+/*
+ * invalidate retransmit slot for event id
+ * return its data buffer or NULL if retransmission is disabled
+ */
+uint8_t *retx_begin(uint32_t id) {
+  unsigned slot;
+
+  if(retx.depth == 0)
+    return NULL;
+  slot = id % retx.depth;
+  pthread_mutex_lock(&retx.lock);
+  retx.valid[slot] = 0;
+  pthread_mutex_unlock(&retx.lock);
+  return retx.data[slot];
+}
+
+/*
+ * keep sent event sh with payload data (copied unless already in slot)
+ */
+void retx_commit(struct shwr_header *sh, const uint8_t *data) {
+  unsigned slot = sh->id % retx.depth;
+
+  if(data != retx.data[slot])
+    memcpy(retx.data[slot], data, sh->size);
+  pthread_mutex_lock(&retx.lock);
+  retx.sh[slot] = *sh;
+  retx.valid[slot] = 1;
+  pthread_mutex_unlock(&retx.lock);
+}
+
+/*
+ * resend fragments of event id covering nrange byte ranges (start, end)
+ * to dl, whole event with header if nrange == 0
+ * return CTRL_OK or CTRL_ENOENT if the event is not kept
+ */
+uint32_t retx_resend(int sock, struct destlist *dl, uint32_t id,
+		     uint32_t *range, unsigned nrange) {
+  struct iovec seg;
+  unsigned i, slot, start, end;
+  uint32_t status = CTRL_ENOENT;
+
+  if(retx.depth == 0)
+    return status;
+  slot = id % retx.depth;
+  pthread_mutex_lock(&retx.lock);
+  if(retx.valid[slot] && retx.sh[slot].id == id) {
+    seg.iov_base = retx.data[slot];
+    seg.iov_len = retx.sh[slot].size;
+    if(nrange == 0)
+      senddata(sock, dl, &retx.sh[slot], &seg, 1);
+    for(i = 0; i < nrange; i++) {
+      start = range[2*i];
+      if((end = range[2*i + 1]) > seg.iov_len)
+	end = seg.iov_len;
+      if(start < end)
+	sendrange(sock, dl, &retx.sh[slot], &seg, 1, start, end, 0);
+    }
+    status = CTRL_OK; }
+  pthread_mutex_unlock(&retx.lock);
+  return status;
+}
+
+/*
+ * set flow control credit (CREDIT_NOLIMIT: not limited) and policy
+ */
+void credit_set(uint32_t events, uint32_t bytes, int policy) {
+  pthread_mutex_lock(&credit.lock);
+  credit.events = events == CREDIT_NOLIMIT ? LLONG_MAX : events;
+  credit.bytes = bytes == CREDIT_NOLIMIT ? LLONG_MAX : bytes;
+  credit.on = events != CREDIT_NOLIMIT || bytes != CREDIT_NOLIMIT;
+  credit.policy = policy;
+  pthread_cond_signal(&credit.granted);
+  pthread_mutex_unlock(&credit.lock);
+}
+
+/*
+ * return 1 if a datagram may be sent
+ */
+int credit_ok() {
+  int ok;
+
+  pthread_mutex_lock(&credit.lock);
+  ok = !credit.on || (credit.events > 0 && credit.bytes > 0);
+  pthread_mutex_unlock(&credit.lock);
+  return ok;
+}
+
+/*
+ * before sending: in sender thread wait for credit until stopped,
+ * return 0 if there is none; the main thread sends only after
+ * credit_ok() (so a block of averaged records may overdraw), return 1
+ */
+int credit_wait() {
+  int ok;
+
+  if(!credit.wait)
+    return 1;
+  pthread_mutex_lock(&credit.lock);
+  while(!(ok = !credit.on || (credit.events > 0 && credit.bytes > 0))
+	&& !credit.stop)
+    pthread_cond_wait(&credit.granted, &credit.lock);
+  pthread_mutex_unlock(&credit.lock);
+  return ok;
+}
+
+/*
+ * take credit of an event or averaged record of size bytes sent
+ */
+void credit_take(uint32_t size) {
+  pthread_mutex_lock(&credit.lock);
+  if(credit.on) {
+    if(credit.events != LLONG_MAX)
+      credit.events--;
+    if(credit.bytes != LLONG_MAX)
+      credit.bytes -= size; }
+  pthread_mutex_unlock(&credit.lock);
+}
+
+/*
+ * wake up sender thread waiting for credit, it does not wait any more
+ */
+void credit_stop() {
+  pthread_mutex_lock(&credit.lock);
+  credit.stop = 1;
+  pthread_cond_signal(&credit.granted);
+  pthread_mutex_unlock(&credit.lock);
+}
+
+/*
+ * out of credit with CREDIT_DROP: release full shower (if evt & EVT_DATA)
+ * and muon (if evt & EVT_MUON) buffer unsent
+ */
+void credit_drop(int evt) {
+  struct shwr_header sh;
+
+  if((evt & EVT_DATA) && read_evt_header(&sh) == 0) {
+    read_evt_release(sh.rd);
+    stats_count(creditdrops); }
+  if((evt & EVT_MUON) && read_muon_header(&sh) == 0) {
+    read_muon_release(sh.rd);
+    stats_count(creditdrops); }
+}
+
+/*
+ * add samples of trace y to sum and their squares to sumsq
+ */
+void trace_accumulate(const uint16_t *y, uint32_t *sum, uint32_t *sumsq) {
+  unsigned i = 0;
+#ifdef __ARM_NEON__
+  uint16x8_t v;
+  uint16x4_t lo, hi;
+
+  for(; i < SHWR_NSAMPLES; i += 8) {
+    v = vld1q_u16(y + i);
+    lo = vget_low_u16(v);
+    hi = vget_high_u16(v);
+    vst1q_u32(sum + i, vaddw_u16(vld1q_u32(sum + i), lo));
+    vst1q_u32(sum + i + 4, vaddw_u16(vld1q_u32(sum + i + 4), hi));
+    vst1q_u32(sumsq + i, vmlal_u16(vld1q_u32(sumsq + i), lo, lo));
+    vst1q_u32(sumsq + i + 4, vmlal_u16(vld1q_u32(sumsq + i + 4), hi, hi));
   }
+#endif
+  for(; i < SHWR_NSAMPLES; i++) {
+    sum[i] += y[i];
+    sumsq[i] += (uint32_t)y[i] * y[i]; }
+}
 
-  /* periodical signal generation */
-  sev.sigev_notify = SIGEV_SIGNAL;
-  sev.sigev_signo = SIG_WAKEUP;
-  if(timer_create(CLOCK_MONOTONIC, &sev, &t_alarm) != 0){
-    fprintf(stderr, "timer creation error\n");
-    exit(1);
+/*
+ * send sums of block of n traces as SHWR_RAW_NCH_MAX SHWR_FMT_AVERAGE
+ * events with header sh of its last trace
+ */
+void average_send(int sock, struct destlist *dl, struct shwr_header *sh,
+		  unsigned n, uint32_t block) {
+  struct shwr_header ash = *sh;
+  struct average_header *ah;
+  struct iovec seg;
+  const size_t chsize = SHWR_NSAMPLES * sizeof(uint32_t);
+  unsigned adc;
+  uint8_t *out;
+  long long duration;
+
+  for(adc = 0; adc < SHWR_RAW_NCH_MAX; adc++) {
+    if(!credit_wait())
+      return;
+    duration = - time_us();
+    ash.id = AVERAGE_ID | ((block * SHWR_RAW_NCH_MAX + adc) & ID_MASK);
+    ash.format = SHWR_FMT_AVERAGE;
+    ash.size = AVERAGESIZE;
+    if((out = retx_begin(ash.id)) == NULL)
+      out = txbuf;
+    ah = (struct average_header *)out;
+    ah->n = n;
+    ah->adc = adc;
+    memcpy(ah + 1, avgsum[2*adc], 2 * chsize);
+    memcpy((uint8_t *)(ah + 1) + 2*chsize, avgsumsq[2*adc], 2 * chsize);
+    seg.iov_base = out;
+    seg.iov_len = AVERAGESIZE;
+    senddata(sock, dl, &ash, &seg, 1);
+    credit_take(AVERAGESIZE);
+    duration += time_us();
+    stats_hist(HIST_SEND, duration);
+    if(out != txbuf)
+      retx_commit(&ash, out);
+    logsent(&ash, duration);
   }
+}
 
-  ts.it_interval.tv_sec = 0;
-  ts.it_interval.tv_nsec = WAITTIME;
-  ts.it_value.tv_sec = 0;
-  ts.it_value.tv_nsec = WAITTIME;  /*the next interruption */
-  if(timer_settime(t_alarm, 0, &ts, NULL) != 0){
-    exit(1);
+/*
+ * averaging mode: add traces of sh to the current block, send the block
+ * when complete; return 1 if sh is to be sent as well
+ */
+int average_add(int sock, struct destlist *dl, struct shwr_header *sh,
+		uint32_t mode) {
+  static uint32_t curmode = 0, block = 0;
+  static unsigned n = 0;  /* traces in the current block */
+  unsigned ch, every = mode >> AVG_KSHIFT;
+
+  if(mode != curmode) {  /* changed by CTRL_AVERAGE, start a new block */
+    curmode = mode;
+    n = 0; }
+  if(n == 0) {
+    memset(avgsum, 0, sizeof(avgsum));
+    memset(avgsumsq, 0, sizeof(avgsumsq)); }
+  for(ch = 0; ch < SHWR_NCH_MAX; ch++)
+    trace_accumulate(traces[ch], avgsum[ch], avgsumsq[ch]);
+  if(++n == (mode & ((1 << AVG_KSHIFT) - 1))) {
+    average_send(sock, dl, sh, n, block++);
+    n = 0; }
+  return every > 0 && sh->id % every == 0;
+}
+
+/*
+ * send data of work buffer wb, encoded to format
+ * (SHWR_FMT_DELTA first if compress and it is shorter),
+ * as SHWR_FMT_FEATURE in features mode, muon events as they are;
+ * in averaging mode accumulated, sent only each k-th
+ * return 1 if sent, 0 if not
+ */
+int sendwbuf(int sock, struct destlist *dl,
+	     struct shwr_header *sh, uint8_t *wb) {
+  struct iovec seg;
+  const uint32_t *raw = (const uint32_t *)wb;
+  unsigned adc, ch, chsize, n, limit, size = 0;
+  uint32_t mode = 0;
+  uint8_t *out;
+  long long wait, duration = - time_us();
+
+  if(sh->format != SHWR_FMT_MUON) {
+    sh->format = format;
+    mode = __atomic_load_n(&avgmode, __ATOMIC_RELAXED); }
+  /* all encoders work on rotated HG/LG traces */
+  if(sh->format != SHWR_FMT_MUON
+     && (sh->format != SHWR_FMT_RAW || compress || features || mode))
+    for(adc = 0; adc < SHWR_RAW_NCH_MAX; adc++)
+      shwr_split(raw + adc*SHWR_NSAMPLES, SHWR_NSAMPLES, sh->shwr_buf_start,
+		 traces[2*adc], traces[2*adc + 1]);
+  if(mode && !average_add(sock, dl, sh, mode))
+    return 0;
+  wait = - time_us();
+  if(!credit_wait())
+    return 0;
+  duration -= wait + time_us();  /* not the wait for credit */
+  /* encode directly to retransmit slot if kept */
+  if((out = retx_begin(sh->id)) == NULL)
+    out = txbuf;
+  if(features && sh->format != SHWR_FMT_MUON
+     && (traceevery == 0 || sh->id % traceevery != 0)) {
+    size = feature_encode(traces, out);
+    sh->format = SHWR_FMT_FEATURE; }
+  else if(compress && sh->format != SHWR_FMT_MUON) {
+    limit = (format == SHWR_FMT_PACKED12) ? PACKED12SIZE : DATASIZE;
+    for(ch = 0; ch < SHWR_NCH_MAX; ch++, size += n)
+      if((n = delta_encode(traces[ch], out + size, limit - size)) == 0)
+	break;
+    if(ch == SHWR_NCH_MAX && size < limit)
+      sh->format = SHWR_FMT_DELTA;
   }
 
-  gl.id_counter=0;
+  switch(sh->format) {
+  case SHWR_FMT_DELTA:
+  case SHWR_FMT_FEATURE:
+    seg.iov_base = out;
+    seg.iov_len = size;
+    break;
+  case SHWR_FMT_PACKED12:
+    chsize = SHWR_NSAMPLES * 3 / 2;
+    for(ch = 0; ch < SHWR_NCH_MAX; ch++)
+      pack12(traces[ch], out + ch*chsize);
+    seg.iov_base = out;
+    seg.iov_len = PACKED12SIZE;
+    break;
+  case SHWR_FMT_MUON:
+    seg.iov_base = wb;
+    seg.iov_len = sh->size;
+    break;
+  default:
+    seg.iov_base = wb;
+    seg.iov_len = DATASIZE;
+    break;
+  }
+  sh->size = seg.iov_len;
+  senddata(sock, dl, sh, &seg, 1);
+  credit_take(sh->size);
+  stats_hist(HIST_SEND, duration + time_us());
+  if(out != txbuf)
+    retx_commit(sh, seg.iov_base);
+  return 1;
 }
 
-void read_evt_end() {
-  int i;
+/*
+ * copy current data destinations to dl
+ */
+void getdest(struct destlist *dl) {
+  pthread_mutex_lock(&destlock);
+  *dl = dest;
+  pthread_mutex_unlock(&destlock);
+}
 
-  if(gl.regs != NULL)
-    munmap((void *)gl.regs, gl.regs_size);
+/*
+ * sender thread of pipelined mode: send filled work buffers
+ * until woken up with an empty ring
+ */
+void *sender(void *arg) {
+  struct destlist dl;
+  unsigned tail, slot;
+  uint64_t one = 1;
 
-  if(gl.tt_regs != NULL)
-    munmap((void *)gl.tt_regs, gl.regs_size);
+  mylog = &logring[1];
+  for(;;) {
+    while(sem_wait(&ring.filled) < 0 && errno == EINTR)
+      ;
+    tail = __atomic_load_n(&ring.tail, __ATOMIC_RELAXED);
+    if(tail == __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE))
+      break;
+    slot = tail % NWORKBUF;
+    getdest(&dl);
+    if(sendwbuf(ring.sock, &dl, &ring.sh[slot], wbuf(slot)))
+      logsent(&ring.sh[slot], ring.duration[slot]);
+    __atomic_store_n(&ring.tail, tail + 1, __ATOMIC_RELEASE);
+    if(write(ring.spacefd, &one, sizeof(one)) != sizeof(one))
+      logmsg(errno, "sender: eventfd write failed", 0);
+  }
+  return NULL;
+}
+
+/*
+ * start sender thread, one step below real-time priority of readout
+ */
+void sender_start(pthread_t *thread, int sock) {
+  pthread_attr_t attr;
+  int res;
 
-  if(gl.tstctl_regs != NULL)
-      munmap((void *)gl.tstctl_regs, gl.regs_size);
+  ring.head = ring.tail = 0;
+  ring.sock = sock;
+  if(sem_init(&ring.filled, 0, 0) < 0 ||
+     (ring.spacefd = eventfd(0, EFD_NONBLOCK)) < 0) {
+    fprintf(stderr, "Cannot initialize work ring: %s\n", strerror(errno));
+    exit(1); }
+
+  pthread_attr_init(&attr);
+#ifdef REALTIME
+  struct sched_param sched_p;
+  sched_p.sched_priority = rtprio > 1 ? rtprio - 1 : 1;
+  pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+  pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+  pthread_attr_setschedparam(&attr, &sched_p);
+#endif
+  if((res = pthread_create(thread, &attr, sender, NULL)) != 0) {
+    fprintf(stderr, "Cannot create sender thread: %s\n", strerror(res));
+    exit(1); }
+  pthread_attr_destroy(&attr);
+}
 
-  for( i=0; i < SHWR_RAW_NCH_MAX; i++ ) {
-    if(gl.shwr_pt[i] != NULL)
-      munmap((void *)gl.shwr_pt[i], gl.shwr_mem_size); }
+/*
+ * wake up sender with empty ring and wait until it sends pending buffers
+ * (those waiting for credit are not sent)
+ */
+void sender_stop(pthread_t thread) {
+  credit_stop();
+  sem_post(&ring.filled);
+  pthread_join(thread, NULL);
+  sem_destroy(&ring.filled);
+  close(ring.spacefd);
 }
 
 /*
- * read out FADC to buf and fill shwr_header
- * return time for data acquisition in us
+ * trigger settings
  */
-long long read_evt_read(struct shwr_header* sh, uint8_t *buf) {
-  uint32_t volatile *st;
-  void *pt_aux;
-  uint32_t aux;
-  uint32_t *fadc;
-  int rd, sig, i;
-  int offset;
-  struct timeval tval;
-  long long duration;
+void trig_ext() {
+  gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = COMPATIBILITY_SHWR_BUF_TRIG_EXT;
+}
 
-  fadc = (uint32_t *)buf;
-
-  st = &(gl.regs[SHWR_BUF_STATUS_ADDR]);
-
-  /*wait for the periodical signal and check if there is a
-    event trigger
-  */
-  aux = SHWR_BUF_NFULL_MASK << SHWR_BUF_NFULL_SHIFT;
-  sig = SIG_WAKEUP;
-  while( ((*st) & aux) == 0 && sig == SIG_WAKEUP)
-    sig = sigwaitinfo(&gl.sigset, NULL);
-
-  if(sig == SIG_WAKEUP){
-    gettimeofday(&tval, NULL);
-    duration = - (tval.tv_sec * 1000000L + tval.tv_usec);
-    rd = (((*st) >> SHWR_BUF_RNUM_SHIFT) & SHWR_BUF_RNUM_MASK);
-    offset = rd * SHWR_NSAMPLES;
-    for(i = 0; i < SHWR_RAW_NCH_MAX; i++){
-      pt_aux = (void *)(gl.shwr_pt[i] + offset);
-      memcpy(fadc, pt_aux, sizeof(uint32_t)*SHWR_NSAMPLES);
-      fadc += SHWR_NSAMPLES;
-    }
-    sh->id = gl.id_counter;
-    sh->shwr_buf_status   = gl.regs[SHWR_BUF_STATUS_ADDR];
-    sh->shwr_buf_start    = gl.regs[SHWR_BUF_START_ADDR];
-    sh->shwr_buf_trig_id  = gl.regs[SHWR_BUF_TRIG_ID_ADDR];
-    sh->ttag_shwr_seconds = gl.tt_regs[TTAG_SHWR_SECONDS_ADDR];
-    sh->ttag_shwr_nanosec = gl.tt_regs[TTAG_SHWR_NANOSEC_ADDR];
-    sh->rd = rd;
-    /* release buffer */
-    gl.regs[SHWR_BUF_CONTROL_ADDR] = rd;
-    gl.id_counter++;
-    gettimeofday(&tval, NULL);
-    duration += tval.tv_sec * 1000000L + tval.tv_usec;
-    return(duration);
+/* Full bandwidth single bin, thr[4]: PMT0-2 and SSD */
+void trig_sb(uint32_t *thr, uint32_t enab) {
+  gl.regs[SB_TRIG_THR0_ADDR] = thr[0];
+  gl.regs[SB_TRIG_THR1_ADDR] = thr[1];
+  gl.regs[SB_TRIG_THR2_ADDR] = thr[2];
+  gl.regs[SB_TRIG_SSD_ADDR] = thr[3];
+  gl.regs[SB_TRIG_ENAB_ADDR] = enab;
+  gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = SHWR_BUF_TRIG_SB;
+}
+
+/* Compatibility single bin, thr[3]: PMT0-2 */
+void trig_compat_sb(uint32_t *thr, uint32_t enab) {
+  gl.regs[COMPATIBILITY_SB_TRIG_THR0_ADDR] = thr[0];
+  gl.regs[COMPATIBILITY_SB_TRIG_THR1_ADDR] = thr[1];
+  gl.regs[COMPATIBILITY_SB_TRIG_THR2_ADDR] = thr[2];
+  gl.regs[COMPATIBILITY_SB_TRIG_ENAB_ADDR] = enab;
+  gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = COMPATIBILITY_SHWR_BUF_TRIG_SB;
+}
+
+/* muon single bin trigger n (1, 2), thr[4]: PMT0-2 and SSD
+   fills muon buffers if MUON_BUF_TRIG_SBn is in muon trigger mask */
+int trig_muon(uint32_t n, uint32_t *thr, uint32_t enab) {
+  switch(n) {
+  case 1:
+    gl.regs[MUON_TRIG1_THR0_ADDR] = thr[0];
+    gl.regs[MUON_TRIG1_THR1_ADDR] = thr[1];
+    gl.regs[MUON_TRIG1_THR2_ADDR] = thr[2];
+    gl.regs[MUON_TRIG1_SSD_ADDR] = thr[3];
+    gl.regs[MUON_TRIG1_ENAB_ADDR] = enab;
+    break;
+  case 2:
+    gl.regs[MUON_TRIG2_THR0_ADDR] = thr[0];
+    gl.regs[MUON_TRIG2_THR1_ADDR] = thr[1];
+    gl.regs[MUON_TRIG2_THR2_ADDR] = thr[2];
+    gl.regs[MUON_TRIG2_SSD_ADDR] = thr[3];
+    gl.regs[MUON_TRIG2_ENAB_ADDR] = enab;
+    break;
+  default:
+    return -1;
   }
-  return(-1);
+  return 0;
 }
-  
+
+/* compatibility scaler n (0 - 2: A - C), thr[3]: PMT0-2 */
+int scaler_set(unsigned n, uint32_t *thr, uint32_t enab) {
+  switch(n) {
+  case 0:
+    gl.regs[COMPATIBILITY_SCALER_A_THR0_ADDR] = thr[0];
+    gl.regs[COMPATIBILITY_SCALER_A_THR1_ADDR] = thr[1];
+    gl.regs[COMPATIBILITY_SCALER_A_THR2_ADDR] = thr[2];
+    gl.regs[COMPATIBILITY_SCALER_A_ENAB_ADDR] = enab;
+    break;
+  case 1:
+    gl.regs[COMPATIBILITY_SCALER_B_THR0_ADDR] = thr[0];
+    gl.regs[COMPATIBILITY_SCALER_B_THR1_ADDR] = thr[1];
+    gl.regs[COMPATIBILITY_SCALER_B_THR2_ADDR] = thr[2];
+    gl.regs[COMPATIBILITY_SCALER_B_ENAB_ADDR] = enab;
+    break;
+  case 2:
+    gl.regs[COMPATIBILITY_SCALER_C_THR0_ADDR] = thr[0];
+    gl.regs[COMPATIBILITY_SCALER_C_THR1_ADDR] = thr[1];
+    gl.regs[COMPATIBILITY_SCALER_C_THR2_ADDR] = thr[2];
+    gl.regs[COMPATIBILITY_SCALER_C_ENAB_ADDR] = enab;
+    break;
+  default:
+    return -1;
+  }
+  return 0;
+}
+
+/*
+ * read and execute a command from control socket, reply to the sender
+ * called when control socket is readable
+ * return 1 if acquisition is to stop, 0 otherwise
+ */
+int controlrecv(int sock, int datasock){
+  struct sockaddr_in src_addr;
+  struct destlist dl;
+  socklen_t addrlen = sizeof(src_addr);
+  uint32_t buf[1 + CTRL_MAXARGS], cmd, nargs, status = CTRL_EINVAL, value;
+  uint32_t *args = buf + 1;
+  ssize_t msglen;
+  int stop = 0, nreply = 2;
+
+  msglen = recvfrom(sock, (void *)buf, sizeof(buf), MSG_DONTWAIT,
+		    (struct sockaddr *)&src_addr, &addrlen);
+  if(msglen < (ssize_t)sizeof(uint32_t) || msglen % sizeof(uint32_t))
+    return 0;
+  cmd = buf[0];
+  nargs = msglen / sizeof(uint32_t) - 1;
+
+  switch(cmd) {
+  case CTRL_STOP:
+    if(nargs == 0) {
+      stop = 1;
+      status = CTRL_OK; }
+    break;
+  case CTRL_TRIGMASK:
+    if(nargs == 1) {
+      gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = args[0];
+      status = CTRL_OK; }
+    break;
+  case CTRL_SBTRIG:
+    if(nargs == 5) {
+      trig_sb(args, args[4]);
+      status = CTRL_OK; }
+    break;
+  case CTRL_COMPATSB:
+    if(nargs == 4) {
+      trig_compat_sb(args, args[3]);
+      status = CTRL_OK; }
+    break;
+  case CTRL_DEST:
+    if(nargs == 2 && args[1] > 0 && args[1] < 0x10000) {
+      pthread_mutex_lock(&destlock);
+      dest.n = 1;  /* the only one */
+      dest.sa[0].sin_family = AF_INET;
+      dest.sa[0].sin_addr.s_addr = args[0];
+      dest.sa[0].sin_port = htons(args[1]);
+      pthread_mutex_unlock(&destlock);
+      status = CTRL_OK; }
+    break;
+  case CTRL_ADDDEST:
+  case CTRL_DELDEST:
+    if(nargs == 2 && args[1] > 0 && args[1] < 0x10000)
+      status = setdest(args[0], args[1], cmd == CTRL_ADDDEST);
+    break;
+  case CTRL_MUONMASK:
+    if(nargs == 1) {
+      gl.regs[MUON_BUF_TRIG_MASK_ADDR] = args[0];
+      status = CTRL_OK; }
+    break;
+  case CTRL_MUONTRIG:
+    if(nargs == 6 && trig_muon(args[0], args + 1, args[5]) == 0)
+      status = CTRL_OK;
+    break;
+  case CTRL_NACK:
+    stats_count(nacks);
+    if(nargs >= 1 && nargs % 2 == 1) {
+      getdest(&dl);
+      status = retx_resend(datasock, &dl, args[0], args + 1, nargs / 2); }
+    break;
+  case CTRL_FRAGSIZE:
+    if(nargs == 1 && (value = setpacketsize(args[0])) > 0) {
+      logmsg(0, "datagram size %u", value);
+      status = CTRL_OK;
+      buf[2] = value;
+      nreply = 3; }
+    break;
+  case CTRL_RATES:
+    if(nargs == 1) {
+      value = args[0] > 0 && args[0] < RATESMIN ? RATESMIN : args[0];
+      if(timer_set(ratesfd, value) == 0) {
+	status = CTRL_OK;
+	buf[2] = value;
+	nreply = 3; }}
+    break;
+  case CTRL_SCALER:
+    if(nargs == 5 && scaler_set(args[0], args + 1, args[4]) == 0)
+      status = CTRL_OK;
+    break;
+  case CTRL_AVERAGE:
+    if(nargs == 2 && args[0] <= AVERAGE_MAX && args[1] < 1 << AVG_KSHIFT) {
+      __atomic_store_n(&avgmode, args[0] ? args[0] | args[1] << AVG_KSHIFT
+		       : 0, __ATOMIC_RELAXED);
+      status = CTRL_OK; }
+    break;
+  case CTRL_CREDIT:
+    if(nargs == 3 && args[2] <= CREDIT_DROP) {
+      credit_set(args[0], args[1], args[2]);
+      status = CTRL_OK; }
+    break;
+  }
+  logmsg(0, status == CTRL_OK ? "control command %u, %u args: OK" :
+	 status == CTRL_ENOENT ? "control command %u, %u args: not found" :
+	 "control command %u, %u args: invalid", cmd, nargs);
+
+  buf[0] = cmd | CTRL_REPLY;
+  buf[1] = status;
+  sendto(sock, buf, nreply*sizeof(uint32_t), MSG_DONTWAIT,
+	 (struct sockaddr *)&src_addr, addrlen);
+  return stop;
+}
+
+/*
+ * senddata_hook: count send error to sa, log the first one of each
+ * stats period
+ */
+void senderr_log(const struct sockaddr_in *sa, int err) {
+  if(__atomic_fetch_add(&stats.senderr, 1, __ATOMIC_RELAXED) == 0)
+    logmsg(err, "send to %u.%u.%u.%u failed",
+	   ntohl(sa->sin_addr.s_addr) >> 24,
+	   (ntohl(sa->sin_addr.s_addr) >> 16) & 0xff,
+	   (ntohl(sa->sin_addr.s_addr) >> 8) & 0xff,
+	   ntohl(sa->sin_addr.s_addr) & 0xff);
+}
+
+/*
+ * read_evt_hook: set payload format of a new header and account it
+ * while its buffer is not released
+ */
+void evt_account(struct shwr_header *sh) {
+  if(sh->id & MUON_ID) {
+    sh->format = SHWR_FMT_MUON;
+    stats_count(muons);
+  } else {
+    sh->format = SHWR_FMT_RAW;
+    stats_evt(sh);
+  }
+}
+
+/*
+ * read out a full shower (or muon if muon) buffer to buf and fill sh
+ * return time for data acquisition in us, -1 if no buffer full
+ */
+long long readout(struct shwr_header *sh, uint8_t *buf, int muon) {
+  long long duration;
+
+  duration = muon ? read_muon_read(sh, buf) : read_evt_read(sh, buf);
+  if(duration >= 0)
+    stats_hist(HIST_COPY, duration);
+  return(duration);
+}
+
+/*
+ * zero-copy mode: send full shower (or muon if muon) buffer directly
+ * from FPGA memory, release it after send
+ */
+void zerocopy_send(int sock, struct shwr_header *sh, int muon) {
+  struct iovec seg[SHWR_RAW_NCH_MAX];
+  struct destlist dl;
+  long long duration;
+
+  /* duration includes send, the buffer is held until sent */
+  duration = - time_us();
+  if((muon ? read_muon_header(sh) : read_evt_header(sh)) < 0) {
+    logmsg(0, "read evt error", 0);
+    stats_count(readerr);
+    return; }
+  if(muon)
+    read_muon_segments(sh, seg);
+  else
+    read_evt_segments(sh->rd, seg);
+  getdest(&dl);
+  senddata(sock, &dl, sh, seg, muon ? MUON_NMEM : SHWR_RAW_NCH_MAX);
+  credit_take(sh->size);
+  if(muon)
+    read_muon_release(sh->rd);
+  else
+    read_evt_release(sh->rd);
+  duration += time_us();
+  stats_hist(HIST_SEND, duration);
+  logsent(sh, duration);
+}
+
+/*
+ * synchronous mode: read out full shower (or muon if muon) buffer
+ * to work buffer wb and send it
+ */
+void sync_send(int sock, struct shwr_header *sh, uint8_t *wb, int muon) {
+  struct destlist dl;
+  long long duration;
+
+  duration = readout(sh, wb, muon);
+  if(duration < 0) {
+    logmsg(0, "read evt error", 0);
+    stats_count(readerr);
+    return; }
+  getdest(&dl);
+  if(sendwbuf(sock, &dl, sh, wb))
+    logsent(sh, duration);
+}
+
 int main(int argc, char ** argv) {
-  struct sockaddr_in sa;
+  struct destlist dl;
+  uint32_t thr[4] = {1000, 1000, 1000, 1000};
+  char *trigger = "ext";
   int datasock, controlsock;
   long long duration;
+  int opt, evt, full, nocredit, statsfd, statsperiod = STATSPERIOD, timersfd;
+  int held = 0;
+  unsigned ratesperiod = 0;
+  struct epoll_event ee;
+  unsigned head, slot;
+  uint64_t nfreed, expirations;
+  int pipelined = 0, zerocopy = 0, muon = 0, muonturn = 0;
+  struct iovec rtbuf[7];
+  pthread_t sthread, lthread;
+  char *uiodev = NULL, *sizearg = NULL;
+  unsigned size, avgn, avgk = 0;
+  int i, ttl = MCAST_TTL;
+
+  while ((opt = getopt(argc, argv, "a:A:cC:d:f:F:l:m:MpP:r:R:s:t:T:w:zu:v:Vh"))
+	 != -1) {
+    switch(opt) {
+    case 'a':
+      rtcpu = atoi(optarg);
+      if(rtcpu < 0 || rtcpu >= CPU_SETSIZE) {
+	fprintf(stderr, "Invalid cpu %s\n", optarg);
+	exit(1); }
+      break;
+    case 'A':
+      if(sscanf(optarg, "%u:%u", &avgn, &avgk) < 1 || avgn < 1
+	 || avgn > AVERAGE_MAX || avgk >= 1 << AVG_KSHIFT) {
+	fprintf(stderr, "Invalid averaging %s\n", optarg);
+	exit(1); }
+      avgmode = avgn | avgk << AVG_KSHIFT;
+      break;
+    case 'c':
+      compress = 1;
+      break;
+    case 'C':
+      if(strcmp(optarg, "hold") == 0)
+	credit_set(0, 0, CREDIT_HOLD);
+      else if(strcmp(optarg, "drop") == 0)
+	credit_set(0, 0, CREDIT_DROP);
+      else {
+	fprintf(stderr, "Unknown credit policy %s\n", optarg);
+	exit(1); }
+      break;
+    case 'd':
+      if(dest.n >= NDEST_MAX) {
+	fprintf(stderr, "More than %d destinations\n", NDEST_MAX);
+	exit(1); }
+      if(parsedest(optarg, DATAPORT, dest.sa + dest.n) < 0) {
+	fprintf(stderr, "Invalid destination %s\n", optarg);
+	exit(1); }
+      dest.n++;
+      break;
+    case 'f':
+      if(strcmp(optarg, "raw") == 0)
+	format = SHWR_FMT_RAW;
+      else if(strcmp(optarg, "packed") == 0)
+	format = SHWR_FMT_PACKED12;
+      else {
+	fprintf(stderr, "Unknown format %s\n", optarg);
+	exit(1); }
+      break;
+    case 'F':
+      features = 1;
+      traceevery = strtoul(optarg, NULL, 0);
+      break;
+    case 'l':
+      lograte = strtoul(optarg, NULL, 0);
+      break;
+    case 'm':
+      sizearg = optarg;
+      break;
+    case 'M':
+      muon = 1;
+      break;
+    case 'p':
+      pipelined = 1;
+      break;
+    case 'P':
+      rtprio = atoi(optarg);
+      if(rtprio < sched_get_priority_min(SCHED_FIFO) ||
+	 rtprio > sched_get_priority_max(SCHED_FIFO)) {
+	fprintf(stderr, "Invalid priority %s\n", optarg);
+	exit(1); }
+      break;
+    case 'r':
+      retx.depth = strtoul(optarg, NULL, 0);
+      if(retx.depth > NRETX) {
+	fprintf(stderr, "Retransmit depth %u > %d\n", retx.depth, NRETX);
+	exit(1); }
+      break;
+    case 'R':
+      ratesperiod = strtoul(optarg, NULL, 0);
+      if(ratesperiod > 0 && ratesperiod < RATESMIN) {
+	fprintf(stderr, "Rates period %u < %d ms\n", ratesperiod, RATESMIN);
+	exit(1); }
+      break;
+    case 's':
+      statsperiod = atoi(optarg);
+      break;
+    case 't':
+      trigger = optarg;
+      break;
+    case 'T':
+      ttl = atoi(optarg);
+      if(ttl < 0 || ttl > 255) {
+	fprintf(stderr, "Invalid multicast TTL %s\n", optarg);
+	exit(1); }
+      break;
+    case 'w':
+      if(sscanf(optarg, "%u:%u", &pedstart, &pedend) != 2
+	 || pedend > SHWR_NSAMPLES || pedstart + 2 > pedend) {
+	fprintf(stderr, "Invalid pedestal window %s\n", optarg);
+	exit(1); }
+      break;
+    case 'z':
+      zerocopy = 1;
+      break;
+    case 'u':
+      uiodev = optarg;
+      break;
+    case 'v':
+      verbosity = atoi(optarg);
+      break;
+    case 'V':
+      printver();
+      exit(0);
+      break;
+    case 'h':
+    default:
+      printhelp(argv[0]);
+      exit(0);
+      break;
+    }}
 
   printver();
+  if(pipelined && zerocopy) {
+    fprintf(stderr, "zero-copy mode is synchronous, -p ignored\n");
+    pipelined = 0; }
+  if(zerocopy && (format != SHWR_FMT_RAW || compress || features
+		   || avgmode)) {
+    fprintf(stderr, "zero-copy mode sends raw format only\n");
+    format = SHWR_FMT_RAW;
+    compress = features = avgmode = 0; }
+  if(zerocopy && retx.depth > 0) {
+    fprintf(stderr, "zero-copy mode keeps no events for retransmission\n");
+    retx.depth = 0; }
   // check workbuf vs _workbuf position
 #ifdef BUFALIGN     
   if(workbuf < _workbuf || workbuf >= _workbuf + 8
@@ -409,66 +1601,188 @@ int main(int argc, char ** argv) {
   // set real-time priority
 #ifdef REALTIME
   struct sched_param sched_p;
-  sched_p.sched_priority = 10;
- if(sched_setscheduler(0, SCHED_FIFO, &sched_p) < 0) {
-   fprintf(stderr, "Schedule setting error: %s\n", strerror(errno)); }
+  sched_p.sched_priority = rtprio;
+  if(sched_setscheduler(0, SCHED_FIFO, &sched_p) < 0) {
+    fprintf(stderr, "Schedule setting error: %s\n", strerror(errno));
+  } else if(rtcpu >= 0)
+    fprintf(stderr, "rt: SCHED_FIFO priority %d\n", rtprio);
 #endif
+  if(rtcpu >= 0) {
+    rtbuf[0].iov_base = _workbuf;
+    rtbuf[0].iov_len = sizeof(_workbuf);
+    rtbuf[1].iov_base = txbuf;
+    rtbuf[1].iov_len = sizeof(txbuf);
+    rtbuf[2].iov_base = retx.data;
+    rtbuf[2].iov_len = sizeof(retx.data);
+    rtbuf[3].iov_base = logring;
+    rtbuf[3].iov_len = sizeof(logring);
+    rtbuf[4].iov_base = traces;
+    rtbuf[4].iov_len = sizeof(traces);
+    rtbuf[5].iov_base = avgsum;
+    rtbuf[5].iov_len = sizeof(avgsum);
+    rtbuf[6].iov_base = avgsumsq;
+    rtbuf[6].iov_len = sizeof(avgsumsq);
+    if(rt_setup(rtcpu, rtbuf, 7) > 0)
+      fprintf(stderr, "rt: real-time mode incomplete\n"); }
+  /* real-time threads log through rings, never block on stderr */
+  logger_start(&lthread);
 
   // prepare UDP
-  datasock = opensock(&sa);
+  if(dest.n == 0 && parsedest(SERVER, DATAPORT, dest.sa + dest.n++) < 0)
+    exit(1);
+  for(i = 0; i < dest.n; i++)
+    fprintf(stderr, "data destination %s:%d%s\n",
+	    inet_ntoa(dest.sa[i].sin_addr), ntohs(dest.sa[i].sin_port),
+	    IN_MULTICAST(ntohl(dest.sa[i].sin_addr.s_addr)) ? " multicast" : "");
+  datasock = opensock(ttl);
   controlsock = opencontrolsock();
-  
-  read_evt_init();
-#ifdef TRIG_EXT
-  // set trigger to external
-  gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = COMPATIBILITY_SHWR_BUF_TRIG_EXT;
-#endif
-#ifdef TRIG_SB
-  // set trigger to Full bandwidth single bin
-  gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = SHWR_BUF_TRIG_SB;
-  gl.regs[SB_TRIG_THR0_ADDR] = 1000;
-  gl.regs[SB_TRIG_THR1_ADDR] = 1000;
-  gl.regs[SB_TRIG_THR2_ADDR] = 1000;
-  gl.regs[SB_TRIG_SSD_ADDR] = 1000;
-  gl.regs[SB_TRIG_ENAB_ADDR] = 0x1F;
-#endif
-#ifdef TRIG_SB_MULTI
-  // set trigger to Full bandwidth single bin with multiplicity
-  gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = SHWR_BUF_TRIG_SB;
-  gl.regs[SB_TRIG_THR0_ADDR] = 1000;
-  gl.regs[SB_TRIG_THR1_ADDR] = 1000;
-  gl.regs[SB_TRIG_THR2_ADDR] = 1000;
-  gl.regs[SB_TRIG_SSD_ADDR] = 1000;
-  gl.regs[SB_TRIG_ENAB_ADDR] = 0x7 | 0x30;
-#endif
-#ifdef TRIG_COMPAT_SB
-  // set trigger to Compatibility single bin
-  gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = COMPATIBILITY_SHWR_BUF_TRIG_SB;
-  gl.regs[COMPATIBILITY_SB_TRIG_THR0_ADDR] = 1000;
-  gl.regs[COMPATIBILITY_SB_TRIG_THR1_ADDR] = 1000;
-  gl.regs[COMPATIBILITY_SB_TRIG_THR2_ADDR] = 1000;
-  gl.regs[COMPATIBILITY_SB_TRIG_ENAB_ADDR] = 0x78;
-#endif
+  if(sizearg != NULL) {
+    if(isdigit(sizearg[0]))
+      size = strtoul(sizearg, NULL, 0);
+    else if((size = packetmax = mtu_packetsize(datasock, sizearg)) == 0)
+      exit(1);
+    if(size > PACKETSIZE_MAX || setpacketsize(size) == 0) {
+      fprintf(stderr, "Invalid datagram size %s\n", sizearg);
+      exit(1); }}
+  fprintf(stderr, "datagram size %u\n", packetsize);
+
+  if(read_evt_init(uiodev, muon) != 0)
+    exit(1);
+  read_evt_hook = evt_account;
+  senddata_hook = senderr_log;
+  fprintf(stderr, "waiting for events %s\n",
+	  gl.intr_regs != NULL ? "on shower interrupt" : "by polling");
+  if(strcmp(trigger, "ext") == 0)
+    trig_ext();
+  else if(strcmp(trigger, "sb") == 0)
+    trig_sb(thr, 0x1F);
+  else if(strcmp(trigger, "sbmulti") == 0)  // with multiplicity
+    trig_sb(thr, 0x7 | 0x30);
+  else if(strcmp(trigger, "compatsb") == 0)
+    trig_compat_sb(thr, 0x78);
+  else {
+    fprintf(stderr, "Unknown trigger %s\n", trigger);
+    exit(1); }
   // set fake GPS
   gl.tstctl_regs[USE_FAKE_ADDR] |= 1 << USE_FAKE_PPS_BIT;
 
-  while(controlrecv(controlsock) <= 0) {
-    duration = read_evt_read(&sh, databuf);
-    if(duration < 0) {
-      fprintf(stderr, "read evt error\n");
+  /* stats and rates timers, both behind one pollable epoll fd */
+  if((statsfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK)) < 0
+     || (ratesfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK)) < 0
+     || (timersfd = epoll_create1(0)) < 0) {
+    fprintf(stderr, "timer creation error\n");
+    exit(1); }
+  ee.events = EPOLLIN;
+  ee.data.fd = statsfd;
+  epoll_ctl(timersfd, EPOLL_CTL_ADD, statsfd, &ee);
+  ee.data.fd = ratesfd;
+  epoll_ctl(timersfd, EPOLL_CTL_ADD, ratesfd, &ee);
+  if(statsperiod > 0) {
+    if(timer_set(statsfd, statsperiod * 1000) != 0) {
+      fprintf(stderr, "timer setting error\n");
+      exit(1); }
+    getdest(&dl);
+    stats_send(datasock, &dl);  /* start of the first interval */
+  }
+  if(ratesperiod > 0 && timer_set(ratesfd, ratesperiod) != 0) {
+    fprintf(stderr, "timer setting error\n");
+    exit(1); }
+
+  credit.wait = pipelined;
+  if(pipelined)
+    sender_start(&sthread, datasock);
+  else if((ring.spacefd = eventfd(0, EFD_NONBLOCK)) < 0) {
+    fprintf(stderr, "Cannot create eventfd: %s\n", strerror(errno));
+    exit(1); }
+
+  for(;;) {
+    nocredit = !credit_ok();
+    /* all work buffers waiting for sender or credit (synchronous modes:
+       out of credit): do not release shower buffers, unless dropped;
+       the eventfd of synchronous modes is never written */
+    full = pipelined ? ring.head - __atomic_load_n(&ring.tail,
+						    __ATOMIC_ACQUIRE)
+      == NWORKBUF : nocredit;
+    /* count entries into the held states, not passes of the loop */
+    if(full && nocredit && held != 2)
+      stats_count(nocredit);
+    else if(full && !nocredit && held != 1)
+      stats_count(ringfull);
+    held = full ? 1 + nocredit : 0;
+    evt = read_evt_wait(controlsock, full && !(nocredit && credit.policy
+					       == CREDIT_DROP)
+			? ring.spacefd : -1, timersfd);
+    if(evt < 0) {
+      fprintf(stderr, "wait evt error: %s\n", strerror(errno));
+      break; }
+    if((evt & EVT_CTRL) && controlrecv(controlsock, datasock) > 0)
+      break;
+    if(evt & EVT_TIMER) {
+      getdest(&dl);
+      if(read(statsfd, &expirations, sizeof(expirations)) > 0)
+	stats_send(datasock, &dl);
+      else if(errno != EAGAIN)
+	logmsg(errno, "timer read error", 0);
+      if(read(ratesfd, &expirations, sizeof(expirations)) > 0)
+	rates_send(datasock, &dl);
+      else if(errno != EAGAIN)
+	logmsg(errno, "timer read error", 0); }
+    if(evt & EVT_XFD)
+      if(read(ring.spacefd, &nfreed, sizeof(nfreed)) < 0 && errno != EAGAIN)
+	logmsg(errno, "eventfd read error", 0);
+    if(!(evt & (EVT_DATA | EVT_MUON)))
+      continue;
+    if(full && nocredit) {
+      credit_drop(evt);
+      continue; }
+
+    if(zerocopy) {
+      if(evt & EVT_DATA)
+	zerocopy_send(datasock, &ring.sh[0], 0);
+      if((evt & EVT_MUON) && credit_ok())
+	zerocopy_send(datasock, &ring.sh[0], 1);
       continue; }
-    senddata(datasock, &sa);
-    fprintf(stderr, "sent id %08x, rd %d, time %9d.%09d [s.tics], evt %1x"
-	    ", duration %lld [us]\n",
-	    sh.id, sh.rd, sh.ttag_shwr_seconds,
-	    sh.ttag_shwr_nanosec & TTAG_NANOSEC_MASK,
-	    sh.ttag_shwr_nanosec >> TTAG_EVTCTR_SHIFT,
-	    duration);
+
+    if(!pipelined) {
+      if(evt & EVT_DATA)
+	sync_send(datasock, &ring.sh[0], wbuf(0), 0);
+      if((evt & EVT_MUON) && credit_ok())
+	sync_send(datasock, &ring.sh[0], wbuf(0), 1);
+      continue; }
+
+    /* drain all full shower and muon buffers into free work buffers,
+       alternating the streams while both have full buffers */
+    while((head = ring.head) - __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE)
+	  < NWORKBUF) {
+      slot = head % NWORKBUF;
+      duration = -1;
+      if(muon && (muonturn ^= 1))
+	duration = readout(&ring.sh[slot], wbuf(slot), 1);
+      if(duration < 0)
+	duration = readout(&ring.sh[slot], wbuf(slot), 0);
+      if(duration < 0 && muon)
+	duration = readout(&ring.sh[slot], wbuf(slot), 1);
+      if(duration < 0)
+	break;
+      stats_lin(HIST_RING,
+		head - __atomic_load_n(&ring.tail, __ATOMIC_RELAXED));
+      ring.duration[slot] = duration;
+      __atomic_store_n(&ring.head, head + 1, __ATOMIC_RELEASE);
+      sem_post(&ring.filled);
+    }
   }
 
+  if(pipelined)
+    sender_stop(sthread);
+  else
+    close(ring.spacefd);
   read_evt_end();
+  close(timersfd);
+  close(ratesfd);
+  close(statsfd);
   close(controlsock);
   close(datasock);
+  logger_stop(lthread);
   
   return(0);
 }
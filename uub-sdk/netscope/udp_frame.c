@@ -0,0 +1,158 @@
+/* Framing of netscope events into UDP datagrams, see udp_frame.h */
+
+#define _GNU_SOURCE   /* sendmmsg */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include "udp_frame.h"
+
+unsigned packetsize = PACKETSIZE;
+unsigned packetmax = PACKETSIZE_MAX;
+void (*senddata_hook)(const struct sockaddr_in *sa, int err) = NULL;
+
+/*
+ * parse destination addr[:port] (port default dflport) into sa
+ * return 0, -1 if invalid
+ */
+int parsedest(const char *arg, unsigned dflport, struct sockaddr_in *sa) {
+  char host[INET_ADDRSTRLEN];
+  const char *colon;
+  unsigned long port = dflport;
+  char *end;
+
+  memset((char *) sa, 0, sizeof(struct sockaddr_in));
+  sa->sin_family = AF_INET;
+  if((colon = strchr(arg, ':')) == NULL)
+    colon = arg + strlen(arg);
+  else if((port = strtoul(colon + 1, &end, 0)) == 0 || port >= 0x10000
+	  || *end != '\0')
+    return -1;
+  if(colon - arg >= INET_ADDRSTRLEN)
+    return -1;
+  memcpy(host, arg, colon - arg);
+  host[colon - arg] = '\0';
+  if(inet_aton(host, &sa->sin_addr) == 0)
+    return -1;
+  sa->sin_port = htons(port);
+  return 0;
+}
+
+/*
+ * set datagram size to at most size, limited by packetmax
+ * return size used or 0 if too small
+ */
+unsigned setpacketsize(unsigned size) {
+  if(size < PACKETSIZE_MIN)
+    return 0;
+  if(size > packetmax)
+    size = packetmax;
+  __atomic_store_n(&packetsize, size, __ATOMIC_RELAXED);
+  return size;
+}
+
+/*
+ * return the largest datagram fitting MTU of interface ifname, 0 on error
+ */
+unsigned mtu_packetsize(int sock, const char *ifname) {
+  struct ifreq ifr;
+
+  memset(&ifr, 0, sizeof(ifr));
+  strncpy(ifr.ifr_name, ifname, IFNAMSIZ-1);
+  if(ioctl(sock, SIOCGIFMTU, &ifr) < 0) {
+    fprintf(stderr, "cannot get MTU of %s: %s\n", ifname, strerror(errno));
+    return 0; }
+  if(ifr.ifr_mtu - IPUDPHDRSIZE > PACKETSIZE_MAX)
+    return PACKETSIZE_MAX;
+  return ifr.ifr_mtu - IPUDPHDRSIZE;
+}
+
+/*
+ * send data bytes [from, to) in fragments, preceded by shwr_header if header
+ * data are given as nseg segments, each at least one fragment long but the
+ * last; all datagrams are passed to kernel by one sendmmsg call per
+ * destination of dl, each fragment is frag_header + data up to packetsize
+ * at most; a destination failing is skipped for the rest of the event
+ */
+void sendrange(int sock, struct destlist *dl,
+	       struct shwr_header *sh, struct iovec *seg, int nseg,
+	       unsigned from, unsigned to, int header) {
+  struct shwr_header hdr;
+  struct frag_header fh[NFRAG + 1];  /* indexed by msg */
+  struct iovec iov[3*NFRAG + 1];
+  struct mmsghdr msg[NFRAG + 1];
+  unsigned i, start, end, len, n, segoff, nmsg, niov, fragsize;
+  int d, res;
+
+  fragsize = FRAGSIZE(__atomic_load_n(&packetsize, __ATOMIC_RELAXED));
+  memset(msg, 0, sizeof(msg));
+
+  /* header */
+  niov = nmsg = 0;
+  if(header) {
+    hdr = *sh;
+    hdr.id |= 0x80000000;
+    iov[0].iov_base = &hdr;
+    iov[0].iov_len = sizeof(struct shwr_header);
+    msg[0].msg_hdr.msg_iov = iov;
+    msg[0].msg_hdr.msg_iovlen = 1;
+    niov = nmsg = 1; }
+
+  /* fragments */
+  for(segoff = from; nseg > 0 && segoff >= seg->iov_len; nseg--, seg++)
+    segoff -= seg->iov_len;
+  for(start = from; start < to; start = end, nmsg++) {
+    if((end = start + fragsize) > to)
+      end = to;
+    fh[nmsg].id = sh->id;
+    fh[nmsg].start = start;
+    fh[nmsg].end = end;
+    msg[nmsg].msg_hdr.msg_iov = iov + niov;
+    iov[niov].iov_base = fh + nmsg;
+    iov[niov++].iov_len = sizeof(struct frag_header);
+    for(len = end - start; len > 0; len -= n, niov++) {
+      if((n = seg->iov_len - segoff) > len)
+	n = len;
+      iov[niov].iov_base = (uint8_t *)seg->iov_base + segoff;
+      iov[niov].iov_len = n;
+      if((segoff += n) == seg->iov_len) {
+	seg++;
+	segoff = 0; }
+    }
+    msg[nmsg].msg_hdr.msg_iovlen = iov + niov - msg[nmsg].msg_hdr.msg_iov;
+  }
+
+  for(d = 0; d < dl->n; d++) {
+    for(i = 0; i < nmsg; i++) {
+      msg[i].msg_hdr.msg_name = dl->sa + d;
+      msg[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+    for(i = 0; i < nmsg; i += res)
+      if((res = sendmmsg(sock, msg + i, nmsg - i, 0)) < 0) {
+	if(errno == EINTR) {
+	  res = 0;
+	  continue; }
+	if(senddata_hook != NULL)
+	  senddata_hook(dl->sa + d, errno);
+	else
+	  fprintf(stderr, "senddata to %s failed: %s\n",
+		  inet_ntoa(dl->sa[d].sin_addr), strerror(errno));
+	break; }
+  }
+}
+
+/*
+ * send data: shwr_header and whole data in fragments
+ */
+void senddata(int sock, struct destlist *dl,
+	      struct shwr_header *sh, struct iovec *seg, int nseg) {
+  unsigned i, size;
+
+  for(i = 0, size = 0; i < nseg; i++)
+    size += seg[i].iov_len;
+  sendrange(sock, dl, sh, seg, nseg, 0, size, 1);
+}
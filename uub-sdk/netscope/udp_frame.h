@@ -0,0 +1,125 @@
+#ifndef UDP_FRAME_H
+#define UDP_FRAME_H
+
+/* Framing of netscope events into UDP datagrams, payload formats
+   an event is a datagram with struct shwr_header (id | 0x80000000)
+   followed by fragments: struct frag_header and payload bytes
+   [start, end), all little endian */
+
+#include <stdint.h>
+#include <netinet/in.h>
+#include <sys/uio.h>
+#include "read_evt.h"
+
+#define PACKETSIZE 1400  /* default datagram size, including frag header */
+#define PACKETSIZE_MIN 512
+#define PACKETSIZE_MAX 8972  /* jumbo frame: MTU 9000 - IP and UDP headers */
+#define IPUDPHDRSIZE 28
+#define NDEST_MAX 4      /* data destinations, unicast or multicast */
+#define FRAME_MAXSIZE (MUONSIZE > DATASIZE ? MUONSIZE : DATASIZE)
+
+struct frag_header {
+  uint32_t id;
+  uint16_t start;
+  uint16_t end;
+};
+
+#define FRAGSIZE(packetsize) ((packetsize) - sizeof(struct frag_header))
+#define NFRAG ((FRAME_MAXSIZE + FRAGSIZE(PACKETSIZE_MIN) - 1) \
+	       / FRAGSIZE(PACKETSIZE_MIN))  /* max. number of fragments */
+
+/* payload formats
+   RAW: SHWR_RAW_NCH_MAX x SHWR_NSAMPLES 32-bit words as in shower memory
+        (HG in bits 0-11, LG in bits 16-27), not rotated by shwr_buf_start
+   PACKED12: SHWR_NCH_MAX channels (HG0, LG0, HG1, ...) x SHWR_NSAMPLES
+        12-bit samples rotated by shwr_buf_start, two consecutive samples
+        s0, s1 in three bytes: s0 & 0xff, s0 >> 8 | (s1 & 0xf) << 4, s1 >> 4
+   DELTA: SHWR_NCH_MAX channels as in PACKED12, each channel coded as
+        first differences (the first one from 0), zigzag mapped to unsigned
+        (d << 1 ^ d >> 31) and cut into blocks of DELTA_BLOCK values;
+        a block is one byte w (bits per value, 0-13) followed by
+        DELTA_BLOCK*w/8 bytes of values packed LSB first
+   MUON: muon event, the same header with id | MUON_ID and muon registers
+        shwr_buf_status: MUON_BUF_STATUS, shwr_buf_start: MUON_BUF_TIME_TAG_A,
+        shwr_buf_trig_id: MUON_BUF_TIME_TAG_B, ttag_shwr_*: TTAG_MUON_*;
+        payload size/8 32-bit words of MUON0 memory followed by the same
+        number of MUON1 words
+   FEATURE: struct feature_header followed by SHWR_NCH_MAX x struct feature
+        (HG0, LG0, HG1, ...) computed from samples rotated by shwr_buf_start
+   AVERAGE: sums over a block of n traces of one ADC: struct average_header
+        followed by uint32_t sum[2][SHWR_NSAMPLES] (HG, LG) and
+        sumsq[2][SHWR_NSAMPLES] of samples rotated by shwr_buf_start;
+        a block is SHWR_RAW_NCH_MAX such events (the whole would not fit
+        16-bit fragment offsets) with id AVERAGE_ID | (block *
+        SHWR_RAW_NCH_MAX + adc), the header of the last trace otherwise */
+#define SHWR_FMT_RAW      0
+#define SHWR_FMT_PACKED12 1
+#define SHWR_FMT_DELTA    2
+#define SHWR_FMT_MUON     3
+#define SHWR_FMT_FEATURE  4
+#define SHWR_FMT_AVERAGE  5
+#define DELTA_BLOCK 64
+
+struct feature_header {
+  uint16_t pedstart, pedend;  /* pedestal window [pedstart, pedend) */
+};
+
+struct feature {
+  float mean;        /* mean over pedestal window */
+  float rms;         /* standard deviation (n-1) over pedestal window */
+  uint16_t peak;     /* max. sample of the trace */
+  uint16_t peakpos;  /* first position of peak */
+};
+
+struct average_header {
+  uint16_t n;    /* traces summed, up to AVERAGE_MAX */
+  uint16_t adc;  /* channels HG adc, LG adc */
+};
+#define AVERAGE_MAX 256       /* sumsq of 12-bit samples fits 32 bits */
+#define AVERAGE_ID 0x20000000  /* averaged block ids, not shower or muon */
+
+#define PACKED12SIZE (SHWR_NCH_MAX * SHWR_NSAMPLES * 3 / 2)
+#define FEATURESIZE (sizeof(struct feature_header) \
+		     + SHWR_NCH_MAX * sizeof(struct feature))
+#define AVERAGESIZE (sizeof(struct average_header) \
+		     + 4 * SHWR_NSAMPLES * sizeof(uint32_t))
+/* first word of netscope stats and rates datagrams, header id never
+   has them */
+#define STATS_MAGIC 0xFFFF5354
+#define RATES_MAGIC 0xFFFF5254
+
+/* data destinations, each gets all datagrams */
+struct destlist {
+  int n;
+  struct sockaddr_in sa[NDEST_MAX];
+};
+
+/* datagram size, set by setpacketsize up to packetmax,
+   read by senders by __atomic builtins */
+extern unsigned packetsize;
+extern unsigned packetmax;
+
+/* parse destination addr[:port] (port default dflport) into sa
+   return 0, -1 if invalid */
+int parsedest(const char *arg, unsigned dflport, struct sockaddr_in *sa);
+
+/* set datagram size to at most size, limited by packetmax
+   return size used or 0 if too small */
+unsigned setpacketsize(unsigned size);
+/* return the largest datagram fitting MTU of interface ifname, 0 on error */
+unsigned mtu_packetsize(int sock, const char *ifname);
+
+/* if not NULL, called with errno on a send error to destination sa,
+   the rest of the event is not sent there (to stderr if NULL) */
+extern void (*senddata_hook)(const struct sockaddr_in *sa, int err);
+
+/* send payload bytes [from, to) of sh given in nseg segments to all dl,
+   preceded by shwr_header if header; on error to one skip it */
+void sendrange(int sock, struct destlist *dl,
+	       struct shwr_header *sh, struct iovec *seg, int nseg,
+	       unsigned from, unsigned to, int header);
+/* send shwr_header and the whole payload in fragments */
+void senddata(int sock, struct destlist *dl,
+	      struct shwr_header *sh, struct iovec *seg, int nseg);
+
+#endif /* UDP_FRAME_H */
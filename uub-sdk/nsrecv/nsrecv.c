@@ -0,0 +1,574 @@
+/* Host receiver of netscope events, see nsrecv.h */
+
+#define _GNU_SOURCE   /* recvmmsg */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "nsrecv.h"
+#include "shwr_split.h"
+
+#define NSR_HDRID 0x80000000
+#define NSR_LEGACYHDR (7 * sizeof(uint32_t))  /* header before format */
+#define MAPWORDS ((FRAME_MAXSIZE + 63) / 64)
+
+/* slot states */
+#define SLOT_FREE    0
+#define SLOT_FILLING 1   /* in hash, being reassembled */
+#define SLOT_DONE    2   /* in done queue */
+#define SLOT_OUT     3   /* handed out by nsr_next */
+
+struct slot {
+  struct nsr_event ev;   /* first, nsr_event pointers are slot ones */
+  int state, header;
+  int next;              /* hash chain or free list, -1 at the end */
+  uint32_t covered;      /* bytes set in map */
+  uint64_t *map;         /* coverage, one bit per payload byte */
+};
+
+/* key of a completed event */
+struct recent {
+  uint32_t addr, port, id;
+};
+
+struct nsr {
+  int sock;
+  unsigned nslot, nbucket;
+  struct slot *slots;
+  int *bucket;           /* hash chains of filling slots */
+  int freelist;
+  int *done;             /* ring of completed slots, nslot + 1 */
+  unsigned dhead, dtail;
+  struct recent recent[NSR_NRECENT];  /* ring of completed events */
+  unsigned nrecent;      /* events put in recent */
+  pthread_mutex_t lock;
+  struct nsr_stats st;
+  uint8_t *data;         /* slot payloads */
+  uint64_t *maps;        /* slot coverage maps */
+  uint8_t (*buf)[PACKETSIZE_MAX];  /* recvmmsg batch */
+  struct mmsghdr msg[NSR_NBATCH];
+  struct iovec iov[NSR_NBATCH];
+  struct sockaddr_in from[NSR_NBATCH];
+};
+
+static long long now_us(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+static unsigned hashkey(struct nsr *r, uint32_t addr, uint32_t port,
+			uint32_t id) {
+  uint32_t h = (addr * 2654435761u) ^ (port * 40503u) ^ (id * 2246822519u);
+
+  return (h ^ h >> 15) & (r->nbucket - 1);
+}
+
+/*
+ * set bits [s, e) of map, return number of newly set ones
+ */
+static uint32_t map_set(uint64_t *map, uint32_t s, uint32_t e) {
+  uint32_t w, we = (e - 1) >> 6, n = 0;
+  uint64_t mask;
+
+  for(w = s >> 6; w <= we; w++) {
+    mask = ~0ULL;
+    if(w == s >> 6)
+      mask &= ~0ULL << (s & 63);
+    if(w == we)
+      mask &= ~0ULL >> (63 - ((e - 1) & 63));
+    n += __builtin_popcountll(mask & ~map[w]);
+    map[w] |= mask;
+  }
+  return n;
+}
+
+/*
+ * first bit >= pos of map equal to set, size if none below size
+ */
+static uint32_t map_find(const uint64_t *map, uint32_t pos, uint32_t size,
+			 int set) {
+  uint64_t w;
+  uint32_t p;
+
+  while(pos < size) {
+    w = set ? map[pos >> 6] : ~map[pos >> 6];
+    w &= ~0ULL << (pos & 63);
+    if(w) {
+      p = (pos & ~63u) + __builtin_ctzll(w);
+      return p < size ? p : size; }
+    pos = (pos | 63) + 1;
+  }
+  return size;
+}
+
+/* number of set bits [0, size) of map */
+static uint32_t map_count(const uint64_t *map, uint32_t size) {
+  uint32_t w, n = 0;
+
+  for(w = 0; w < size >> 6; w++)
+    n += __builtin_popcountll(map[w]);
+  if(size & 63)
+    n += __builtin_popcountll(map[w] & ~(~0ULL << (size & 63)));
+  return n;
+}
+
+static void unhash(struct nsr *r, struct slot *s) {
+  int *p = r->bucket + hashkey(r, s->ev.addr, s->ev.port, s->ev.sh.id);
+
+  while(*p >= 0 && r->slots + *p != s)
+    p = &r->slots[*p].next;
+  if(*p >= 0)
+    *p = s->next;
+}
+
+static void freeslot(struct nsr *r, struct slot *s) {
+  s->state = SLOT_FREE;
+  s->next = r->freelist;
+  r->freelist = s - r->slots;
+}
+
+/*
+ * a free slot, the least recently filled incomplete one evicted if none
+ * return NULL if all are complete or handed out
+ */
+static struct slot *getslot(struct nsr *r) {
+  struct slot *s, *old = NULL;
+  unsigned i;
+
+  if(r->freelist < 0) {
+    for(i = 0; i < r->nslot; i++) {
+      s = r->slots + i;
+      if(s->state == SLOT_FILLING && (old == NULL
+				      || s->ev.tlast < old->ev.tlast))
+	old = s;
+    }
+    if(old == NULL) {
+      r->st.nofree++;
+      return NULL; }
+    unhash(r, old);
+    freeslot(r, old);
+    r->st.evicted++;
+  }
+  s = r->slots + r->freelist;
+  r->freelist = s->next;
+  return s;
+}
+
+/* return 1 if event id from addr:port is in recent */
+static int isrecent(struct nsr *r, uint32_t addr, uint32_t port,
+		    uint32_t id) {
+  unsigned i, n = r->nrecent < NSR_NRECENT ? r->nrecent : NSR_NRECENT;
+
+  for(i = 0; i < n; i++)
+    if(r->recent[i].id == id && r->recent[i].addr == addr
+       && r->recent[i].port == port)
+      return 1;
+  return 0;
+}
+
+static void complete(struct nsr *r, struct slot *s) {
+  s->state = SLOT_DONE;
+  r->done[r->dtail] = s - r->slots;
+  r->dtail = (r->dtail + 1) % (r->nslot + 1);
+}
+
+/*
+ * slot reassembling event id from addr:port, a new one if none
+ */
+static struct slot *lookup(struct nsr *r, uint32_t addr, uint32_t port,
+			   uint32_t id, long long now) {
+  unsigned h = hashkey(r, addr, port, id);
+  struct slot *s;
+  int i;
+
+  for(i = r->bucket[h]; i >= 0; i = s->next) {
+    s = r->slots + i;
+    if(s->ev.sh.id == id && s->ev.addr == addr && s->ev.port == port)
+      return s;
+  }
+  /* resent or duplicated after completion: no new slot */
+  if(isrecent(r, addr, port, id)) {
+    r->st.duplicates++;
+    return NULL; }
+  if((s = getslot(r)) == NULL)
+    return NULL;
+  memset(&s->ev.sh, 0, sizeof(s->ev.sh));
+  memset(s->map, 0, MAPWORDS * sizeof(uint64_t));
+  s->ev.kind = NSR_EVENT;
+  s->ev.addr = addr;
+  s->ev.port = port;
+  s->ev.sh.id = id;
+  s->ev.len = 0;
+  s->ev.tfirst = now;
+  s->state = SLOT_FILLING;
+  s->header = 0;
+  s->covered = 0;
+  s->next = r->bucket[h];
+  r->bucket[h] = s - r->slots;
+  return s;
+}
+
+/*
+ * process one datagram of len bytes from sa
+ */
+static void datagram(struct nsr *r, const uint8_t *buf, unsigned len,
+		     struct sockaddr_in *sa, long long now) {
+  const struct frag_header *fh = (const struct frag_header *)buf;
+  uint32_t addr = ntohl(sa->sin_addr.s_addr), port = ntohs(sa->sin_port);
+  struct slot *s;
+  struct recent *rc;
+  uint32_t id;
+
+  r->st.datagrams++;
+  r->st.bytes += len;
+  if(len < sizeof(uint32_t)) {
+    r->st.invalid++;
+    return; }
+  memcpy(&id, buf, sizeof(id));
+  if(id == STATS_MAGIC || id == RATES_MAGIC) {
+    if(len > FRAME_MAXSIZE || (s = getslot(r)) == NULL)
+      return;
+    s->ev.kind = NSR_STATS;
+    s->ev.addr = addr;
+    s->ev.port = port;
+    s->ev.len = len;
+    s->ev.tfirst = s->ev.tlast = now;
+    memcpy(s->ev.data, buf, len);
+    r->st.stats++;
+    complete(r, s);
+    return; }
+
+  if(id & NSR_HDRID) {
+    if(len != sizeof(struct shwr_header) && len != NSR_LEGACYHDR) {
+      r->st.invalid++;
+      return; }
+    if((s = lookup(r, addr, port, id & ~NSR_HDRID, now)) == NULL)
+      return;
+    if(s->header) {
+      r->st.duplicates++;
+      return; }
+    memcpy(&s->ev.sh, buf, len);
+    if(len == NSR_LEGACYHDR) {
+      s->ev.sh.format = SHWR_FMT_RAW;
+      s->ev.sh.size = DATASIZE; }
+    s->ev.sh.id &= ~NSR_HDRID;
+    if(s->ev.sh.size > FRAME_MAXSIZE) {
+      r->st.invalid++;
+      unhash(r, s);
+      freeslot(r, s);
+      return; }
+    s->header = 1;
+    s->ev.len = s->ev.sh.size;
+    /* fragments before the header may lie beyond the size */
+    if(s->covered > 0)
+      s->covered = map_count(s->map, s->ev.sh.size);
+  } else {
+    if(len < sizeof(struct frag_header) || fh->end <= fh->start
+       || fh->end > FRAME_MAXSIZE
+       || len - sizeof(struct frag_header) != fh->end - fh->start) {
+      r->st.invalid++;
+      return; }
+    if((s = lookup(r, addr, port, id, now)) == NULL)
+      return;
+    if(s->header && fh->end > s->ev.sh.size) {
+      r->st.invalid++;
+      return; }
+    memcpy(s->ev.data + fh->start, fh + 1, fh->end - fh->start);
+    s->covered += map_set(s->map, fh->start, fh->end);
+  }
+  s->ev.tlast = now;
+  if(s->header && s->covered == s->ev.sh.size) {
+    unhash(r, s);
+    r->st.events++;
+    rc = r->recent + r->nrecent++ % NSR_NRECENT;
+    rc->addr = s->ev.addr;
+    rc->port = s->ev.port;
+    rc->id = s->ev.sh.id;
+    complete(r, s);
+  }
+}
+
+struct nsr *nsr_open(const char *laddr, unsigned port, const char *mcast,
+		     int rcvbuf, unsigned nslot) {
+  struct nsr *r;
+  struct sockaddr_in sa;
+  struct ip_mreq mreq;
+  unsigned i;
+  int one = 1;
+
+  if((r = calloc(1, sizeof(*r))) == NULL)
+    return NULL;
+  r->nslot = nslot ? nslot : NSR_NSLOT;
+  for(r->nbucket = 1; r->nbucket < 2 * r->nslot; r->nbucket <<= 1)
+    ;
+  r->slots = calloc(r->nslot, sizeof(struct slot));
+  r->bucket = malloc(r->nbucket * sizeof(int));
+  r->done = malloc((r->nslot + 1) * sizeof(int));
+  r->data = malloc((size_t)r->nslot * FRAME_MAXSIZE);
+  r->maps = malloc((size_t)r->nslot * MAPWORDS * sizeof(uint64_t));
+  r->buf = malloc(NSR_NBATCH * PACKETSIZE_MAX);
+  if(r->slots == NULL || r->bucket == NULL || r->done == NULL
+     || r->data == NULL || r->maps == NULL || r->buf == NULL) {
+    fprintf(stderr, "nsrecv: cannot allocate %u slots\n", r->nslot);
+    r->sock = -1;
+    nsr_close(r);
+    return NULL; }
+  for(i = 0; i < r->nbucket; i++)
+    r->bucket[i] = -1;
+  r->freelist = -1;
+  for(i = r->nslot; i-- > 0; ) {
+    r->slots[i].ev.data = r->data + (size_t)i * FRAME_MAXSIZE;
+    r->slots[i].map = r->maps + (size_t)i * MAPWORDS;
+    freeslot(r, r->slots + i);
+  }
+  for(i = 0; i < NSR_NBATCH; i++) {
+    r->iov[i].iov_base = r->buf[i];
+    r->iov[i].iov_len = PACKETSIZE_MAX;
+    r->msg[i].msg_hdr.msg_iov = r->iov + i;
+    r->msg[i].msg_hdr.msg_iovlen = 1;
+    r->msg[i].msg_hdr.msg_name = r->from + i;
+  }
+  pthread_mutex_init(&r->lock, NULL);
+
+  if((r->sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == -1) {
+    fprintf(stderr, "nsrecv: creating socket failed\n");
+    nsr_close(r);
+    return NULL; }
+  if(rcvbuf <= 0)
+    rcvbuf = NSR_RCVBUF;
+  setsockopt(r->sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+  memset(&sa, 0, sizeof(sa));
+  sa.sin_family = AF_INET;
+  sa.sin_port = htons(port);
+  sa.sin_addr.s_addr = htonl(INADDR_ANY);
+  if(mcast != NULL) {
+    setsockopt(r->sock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if(inet_aton(mcast, &mreq.imr_multiaddr) == 0) {
+      fprintf(stderr, "nsrecv: invalid group %s\n", mcast);
+      nsr_close(r);
+      return NULL; }
+    sa.sin_addr = mreq.imr_multiaddr;
+  } else if(laddr != NULL && *laddr
+	    && inet_aton(laddr, &sa.sin_addr) == 0) {
+    fprintf(stderr, "nsrecv: invalid address %s\n", laddr);
+    nsr_close(r);
+    return NULL; }
+  if(bind(r->sock, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+    fprintf(stderr, "nsrecv: bind to port %u failed: %s\n", port,
+	    strerror(errno));
+    nsr_close(r);
+    return NULL; }
+  if(mcast != NULL) {
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+    if(laddr != NULL && *laddr)
+      inet_aton(laddr, &mreq.imr_interface);
+    if(setsockopt(r->sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq,
+		  sizeof(mreq)) < 0) {
+      fprintf(stderr, "nsrecv: cannot join %s: %s\n", mcast,
+	      strerror(errno));
+      nsr_close(r);
+      return NULL; }}
+  return r;
+}
+
+void nsr_close(struct nsr *r) {
+  if(r == NULL)
+    return;
+  if(r->sock >= 0)
+    close(r->sock);
+  pthread_mutex_destroy(&r->lock);
+  free(r->slots);
+  free(r->bucket);
+  free(r->done);
+  free(r->data);
+  free(r->maps);
+  free(r->buf);
+  free(r);
+}
+
+int nsr_fileno(struct nsr *r) {
+  return r->sock;
+}
+
+struct nsr_event *nsr_next(struct nsr *r, int timeout) {
+  struct pollfd pfd;
+  struct slot *s;
+  long long now, deadline;
+  int i, n;
+
+  deadline = timeout > 0 ? now_us() + timeout * 1000LL : 0;
+  for(;;) {
+    pthread_mutex_lock(&r->lock);
+    if(r->dhead != r->dtail) {
+      s = r->slots + r->done[r->dhead];
+      r->dhead = (r->dhead + 1) % (r->nslot + 1);
+      s->state = SLOT_OUT;
+      pthread_mutex_unlock(&r->lock);
+      return &s->ev; }
+    pthread_mutex_unlock(&r->lock);
+
+    /* value-result, shortened by the previous call */
+    for(i = 0; i < NSR_NBATCH; i++)
+      r->msg[i].msg_hdr.msg_namelen = sizeof(r->from[i]);
+    if((n = recvmmsg(r->sock, r->msg, NSR_NBATCH, MSG_DONTWAIT, NULL)) > 0) {
+      now = now_us();
+      pthread_mutex_lock(&r->lock);
+      for(i = 0; i < n; i++)
+	datagram(r, r->buf[i], r->msg[i].msg_len, r->from + i, now);
+      n = r->dhead == r->dtail;
+      pthread_mutex_unlock(&r->lock);
+      /* datagrams keep coming but none completes an event */
+      if(n && timeout > 0 && now >= deadline)
+	return NULL;
+      continue; }
+    if(n < 0 && errno != EAGAIN && errno != EINTR)
+      return NULL;
+    if(timeout == 0)
+      return NULL;
+    pfd.fd = r->sock;
+    pfd.events = POLLIN;
+    if(timeout > 0 && (timeout = (deadline - now_us() + 999) / 1000) <= 0)
+      return NULL;
+    if(poll(&pfd, 1, timeout) == 0)
+      return NULL;
+  }
+}
+
+void nsr_release(struct nsr *r, struct nsr_event *ev) {
+  struct slot *s = (struct slot *)ev;
+
+  pthread_mutex_lock(&r->lock);
+  if(s->state == SLOT_OUT)
+    freeslot(r, s);
+  pthread_mutex_unlock(&r->lock);
+}
+
+void nsr_clear(struct nsr *r) {
+  struct slot *s;
+  unsigned i;
+
+  pthread_mutex_lock(&r->lock);
+  for(i = 0; i < r->nslot; i++) {
+    s = r->slots + i;
+    if(s->state == SLOT_FILLING || s->state == SLOT_DONE)
+      freeslot(r, s);
+  }
+  for(i = 0; i < r->nbucket; i++)
+    r->bucket[i] = -1;
+  r->dhead = r->dtail = 0;
+  r->nrecent = 0;
+  pthread_mutex_unlock(&r->lock);
+}
+
+int nsr_stalled(struct nsr *r, long long age, struct nsr_event **evs,
+		int n) {
+  long long now = now_us();
+  struct slot *s;
+  unsigned i;
+  int k = 0;
+
+  pthread_mutex_lock(&r->lock);
+  for(i = 0; i < r->nslot && k < n; i++) {
+    s = r->slots + i;
+    if(s->state == SLOT_FILLING && now - s->ev.tlast >= age) {
+      s->ev.tlast = now;
+      evs[k++] = &s->ev; }
+  }
+  pthread_mutex_unlock(&r->lock);
+  return k;
+}
+
+int nsr_missing(struct nsr_event *ev, uint32_t *ranges, int n) {
+  struct slot *s = (struct slot *)ev;
+  uint32_t start, end = 0;
+  int k;
+
+  if(!s->header)
+    return 0;
+  for(k = 0; k < n; k++) {
+    if((start = map_find(s->map, end, ev->sh.size, 0)) >= ev->sh.size)
+      break;
+    end = map_find(s->map, start, ev->sh.size, 1);
+    ranges[2*k] = start;
+    ranges[2*k + 1] = end;
+  }
+  return k;
+}
+
+/*
+ * DELTA payload of len bytes into y, see udp_frame.h
+ * return 0, -1 if truncated
+ */
+static int decode_delta(const uint8_t *p, uint32_t len, uint16_t *y) {
+  uint32_t pos = 0, end, z, mask;
+  uint64_t acc;
+  unsigned i, k, w, nacc;
+  int ch, x;
+
+  for(ch = 0; ch < SHWR_NCH_MAX; ch++) {
+    x = 0;
+    for(i = 0; i < SHWR_NSAMPLES; i += DELTA_BLOCK) {
+      if(pos >= len || (w = p[pos++]) > 16
+	 || (end = pos + DELTA_BLOCK * w / 8) > len)
+	return -1;
+      mask = (1u << w) - 1;
+      for(k = 0, acc = 0, nacc = 0; k < DELTA_BLOCK; k++) {
+	while(nacc < w) {
+	  acc |= (uint64_t)p[pos++] << nacc;
+	  nacc += 8; }
+	z = acc & mask;
+	acc >>= w;
+	nacc -= w;
+	x += (int)(z >> 1) ^ -(int)(z & 1);
+	y[i + k] = x;
+      }
+      pos = end;
+    }
+    y += SHWR_NSAMPLES;
+  }
+  return 0;
+}
+
+int nsr_decode(const struct nsr_event *ev, uint16_t *y) {
+  const uint8_t *p = ev->data;
+  uint16_t *end;
+  int j;
+
+  if(ev->kind != NSR_EVENT)
+    return -1;
+  switch(ev->sh.format) {
+  case SHWR_FMT_RAW:
+    if(ev->sh.size != DATASIZE)
+      return -1;
+    for(j = 0; j < SHWR_RAW_NCH_MAX; j++)
+      shwr_split((const uint32_t *)p + j * SHWR_NSAMPLES, SHWR_NSAMPLES,
+		 ev->sh.shwr_buf_start % SHWR_NSAMPLES,
+		 y + 2*j * SHWR_NSAMPLES, y + (2*j + 1) * SHWR_NSAMPLES);
+    return 0;
+  case SHWR_FMT_PACKED12:
+    if(ev->sh.size != PACKED12SIZE)
+      return -1;
+    for(end = y + SHWR_NCH_MAX * SHWR_NSAMPLES; y < end; y += 2, p += 3) {
+      y[0] = p[0] | (p[1] & 0xf) << 8;
+      y[1] = p[1] >> 4 | p[2] << 4;
+    }
+    return 0;
+  case SHWR_FMT_DELTA:
+    return decode_delta(p, ev->sh.size, y);
+  }
+  return -1;
+}
+
+void nsr_getstats(struct nsr *r, struct nsr_stats *st) {
+  pthread_mutex_lock(&r->lock);
+  *st = r->st;
+  pthread_mutex_unlock(&r->lock);
+}
@@ -0,0 +1,81 @@
+#ifndef NSRECV_H
+#define NSRECV_H
+
+/* Host receiver of netscope events (see ../netscope/udp_frame.h)
+   datagrams read by recvmmsg, reassembled into a preallocated pool of
+   event slots keyed by (sender address, port, id) with byte bitmap
+   coverage; completed events handed out in place until nsr_release
+   nsr_release may be called from another thread than nsr_next */
+
+#include <stdint.h>
+#include "read_evt.h"
+#include "udp_frame.h"
+
+#define NSR_NSLOT 256     /* default number of event slots */
+#define NSR_NBATCH 64     /* datagrams per recvmmsg */
+#define NSR_NRECENT 64    /* completed events kept to drop late datagrams */
+#define NSR_RCVBUF (8 << 20)  /* default socket receive buffer */
+
+/* nsr_event kind */
+#define NSR_EVENT 0   /* netscope event: sh and payload */
+#define NSR_STATS 1   /* stats or rates datagram (*_MAGIC) in data */
+
+struct nsr_event {
+  int kind;
+  uint32_t addr;           /* sender IPv4 address, host order */
+  uint32_t port;           /* sender UDP port */
+  struct shwr_header sh;   /* id without 0x80000000 */
+  uint8_t *data;           /* payload of sh.size bytes, or stats datagram */
+  uint32_t len;            /* bytes in data */
+  long long tfirst, tlast; /* time_us() of first and last datagram */
+};
+
+/* counters since nsr_open */
+struct nsr_stats {
+  uint64_t datagrams, bytes;
+  uint64_t events;      /* completed events */
+  uint64_t stats;       /* stats and rates datagrams */
+  uint64_t evicted;     /* incomplete events dropped for a new one */
+  uint64_t nofree;      /* datagrams dropped, all slots complete or out */
+  uint64_t duplicates;  /* header of an event with header already,
+			   datagrams of a recently completed event */
+  uint64_t invalid;     /* datagrams of wrong length or range */
+};
+
+struct nsr;
+
+/* bind to laddr:port (NULL or "" for any), join multicast group mcast
+   if not NULL, socket receive buffer rcvbuf (0 default), nslot slots
+   (0 default); return NULL on error, message on stderr */
+struct nsr *nsr_open(const char *laddr, unsigned port, const char *mcast,
+		     int rcvbuf, unsigned nslot);
+void nsr_close(struct nsr *r);
+/* socket to poll on before nsr_next(r, 0) */
+int nsr_fileno(struct nsr *r);
+
+/* return the oldest completed event or stats datagram, waiting up to
+   timeout ms (-1 forever), NULL on timeout or error
+   the event stays valid until nsr_release */
+struct nsr_event *nsr_next(struct nsr *r, int timeout);
+void nsr_release(struct nsr *r, struct nsr_event *ev);
+/* drop all incomplete and not yet handed out events */
+void nsr_clear(struct nsr *r);
+
+/* up to n incomplete events without a datagram for age us into evs,
+   their tlast set to now; return number of events; valid until the
+   next nsr_next */
+int nsr_stalled(struct nsr *r, long long age, struct nsr_event **evs, int n);
+/* up to n missing byte ranges of incomplete event ev as start, end
+   pairs into ranges; return number of ranges, 0 if its header is missing
+   (the whole event) */
+int nsr_missing(struct nsr_event *ev, uint32_t *ranges, int n);
+
+/* decode traces of ev (RAW, PACKED12 or DELTA) into
+   y[SHWR_NCH_MAX][SHWR_NSAMPLES] (HG0, LG0, HG1, ...) rotated by
+   shwr_buf_start, i.e. transposed to 2048x10; return 0, -1 if ev has no
+   traces or is invalid */
+int nsr_decode(const struct nsr_event *ev, uint16_t *y);
+
+void nsr_getstats(struct nsr *r, struct nsr_stats *st);
+
+#endif /* NSRECV_H */
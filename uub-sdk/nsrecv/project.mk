@@ -0,0 +1,2 @@
+
+FPGAVERSIONS := 14120220 14120420
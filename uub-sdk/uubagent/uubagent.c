@@ -0,0 +1,485 @@
+/* uubagent
+   Long running UUB test agent: maps the trigger registers and shower
+   memories and opens ADC SPI devices once, then serves UDP commands
+   one at a time (see AGENT_*); acquisition (netscope) and jitter cleaner
+   init run as its child processes
+   standalone adcinit, adcramp, adc_check_ramp and jitter_cleaner do the
+   same jobs without the agent
+*/
+
+#define VERSION "2026-10-14"
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <poll.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "read_evt.h"
+#include "adc_spi.h"
+#include "ramp_check.h"
+
+#define AGENTPORT 8885   /* the port on which to receive commands */
+#define CTRLPORT 8887    /* netscope control port, for AGENT_ACQSTOP */
+#define CTRL_STOP 1      /* netscope stop command */
+#define NETSCOPE "./netscope"
+#define JITTER "./jitter_cleaner"
+#define AGENT_PROTO 1    /* protocol version replied to AGENT_PING */
+#define MSGSIZE 1024     /* max. command datagram */
+#define ACQ_MAXARGS 32   /* max. netscope arguments in AGENT_ACQSTART */
+#define SHOT_TIMEOUT 1   /* max. wait for ramp trace [s] */
+#define MAXSHOTS 1000    /* max. nshots of AGENT_RAMPCHECK */
+#define STOP_TIMEOUT 2000  /* max. wait for netscope exit [ms] */
+#define POLLPERIOD 1000  /* reap children at least each [ms] */
+#define ADC_ALL ((1 << SHWR_RAW_NCH_MAX) - 1)
+
+/* control commands: little endian uint32_t cmd, args
+   reply to sender: cmd | AGENT_REPLY, status (AGENT_OK or AGENT_E*),
+   values */
+#define AGENT_PING      1   /* -> AGENT_PROTO, netscope pid or 0 */
+#define AGENT_ADCINIT   2   /* [adcmask]: write init sequence to ADCs
+			       (default all) -> mask of ADCs with registers
+			       not read back as written */
+#define AGENT_RAMP      3   /* on, [adcmask, [chans]]: set (on != 0) or
+			       clear ramp test mode of channels chans
+			       (bit 0 A, bit 1 B, default both) */
+#define AGENT_RAMPCHECK 4   /* [nshots]: take nshots (1 - MAXSHOTS,
+			       default 1) LED triggered traces in ramp mode
+			       -> mask of failing ADCs, bad shots of
+			       SHWR_NCH_MAX channels (HG0, LG0, HG1, ...) */
+#define AGENT_JCINIT    5   /* [verify]: initialize jitter cleaner, verify
+			       registers if verify != 0 -> exit code */
+#define AGENT_JCVERIFY  6   /* verify jitter cleaner -> exit code */
+#define AGENT_ACQSTART  7   /* NUL separated netscope arguments (padded to
+			       uint32_t): start acquisition -> pid */
+#define AGENT_ACQSTOP   8   /* stop acquisition -> netscope exit code */
+#define AGENT_QUIT      9   /* stop acquisition and exit the agent */
+#define AGENT_REPLY  0x80000000
+#define AGENT_OK        0
+#define AGENT_EINVAL    1   /* unknown command or wrong arguments */
+#define AGENT_EBUSY     2   /* acquisition running (or not for ACQSTOP) */
+#define AGENT_EIO       3   /* SPI error, no trace or child failed */
+#define AGENT_ECHILD    4   /* cannot start child process */
+
+/* global variables */
+int adcfd[SHWR_RAW_NCH_MAX];
+int spi_failed;     /* SPI error in the current command */
+int verbose = 0;
+char *nspath = NETSCOPE, *jcpath = JITTER;
+pid_t acqpid = 0;   /* running netscope */
+volatile sig_atomic_t quit = 0;
+uint32_t _databuf[DATASIZE / sizeof(uint32_t) + 2];
+uint16_t traces[SHWR_NCH_MAX][SHWR_NSAMPLES];
+struct ramp_stats rstats[SHWR_NCH_MAX];
+
+void printhelp(char *progname) {
+  fprintf(stderr, "Usage: %s [-p <port>] [-n <netscope>] [-j <jitter_cleaner>]"
+	  " [-v] [-V] [-h]\n"
+	  "      -p: UDP port for commands (default %d)\n"
+	  "      -n: netscope started by AGENT_ACQSTART (default %s)\n"
+	  "      -j: jitter cleaner init program (default %s)\n"
+	  "      -v: be verbose\n"
+	  "      -V: print version and exit\n"
+	  "      -h: print help and exit\n",
+	  progname, AGENTPORT, NETSCOPE, JITTER);
+}
+
+/*
+ * spi_error handler: report and let the command fail
+ */
+void spi_report(int err, int fd, const char *msg) {
+  if(err == SPI_EWRITE || err == SPI_EREAD)
+    perror(msg);
+  else
+    fprintf(stderr, "%s\n", msg);
+  spi_failed = 1;
+}
+
+void sigquit(int sig) {
+  quit = 1;
+}
+
+/*
+ * control socket: receive commands (AGENT_*), not inherited by children
+ */
+int opencontrolsock(int port) {
+  struct sockaddr_in sa;
+  int sock;
+
+  if ((sock = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP)) == -1) {
+    fprintf(stderr, "creating socket failed\n");
+    exit(1); }
+
+  memset((char *) &sa, 0, sizeof(struct sockaddr_in));
+  sa.sin_family = AF_INET;
+  sa.sin_port = htons(port);
+  sa.sin_addr.s_addr = htonl(INADDR_ANY);
+
+  if (bind(sock, (struct sockaddr*)&sa, sizeof(struct sockaddr_in)) < 0) {
+    fprintf(stderr, "bind failed\n");
+    exit(1); }
+  return sock;
+}
+
+/*
+ * run child: argv[0] with argv, wait for it if wait
+ * return its exit code (wait) or pid, -1 if it cannot be started
+ */
+int runchild(char **argv, int wait) {
+  int status;
+  pid_t pid;
+
+  if((pid = fork()) < 0) {
+    perror("fork");
+    return -1; }
+  if(pid == 0) {
+    execv(argv[0], argv);
+    perror(argv[0]);
+    _exit(127); }
+  if(!wait)
+    return pid;
+  while(waitpid(pid, &status, 0) < 0)
+    if(errno != EINTR)
+      return -1;
+  if(!WIFEXITED(status) || WEXITSTATUS(status) == 127)
+    return -1;
+  return WEXITSTATUS(status);
+}
+
+/*
+ * check if netscope still runs, reap it if not
+ */
+void reapacq(void) {
+  int status;
+
+  if(acqpid > 0 && waitpid(acqpid, &status, WNOHANG) == acqpid) {
+    if(verbose)
+      fprintf(stderr, "netscope %d exited, status %d\n", acqpid,
+	      WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+    acqpid = 0; }
+}
+
+/*
+ * stop netscope: CTRL_STOP to its control port, kill it after STOP_TIMEOUT
+ * return its exit code, -1 if killed
+ */
+int stopacq(void) {
+  uint32_t cmd = CTRL_STOP;
+  struct sockaddr_in sa;
+  int sock, t, status;
+
+  memset((char *) &sa, 0, sizeof(struct sockaddr_in));
+  sa.sin_family = AF_INET;
+  sa.sin_port = htons(CTRLPORT);
+  sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if((sock = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP)) >= 0) {
+    sendto(sock, &cmd, sizeof(cmd), 0, (struct sockaddr *)&sa, sizeof(sa));
+    close(sock); }
+  for(t = 0; t < STOP_TIMEOUT; t += 10) {
+    if(waitpid(acqpid, &status, WNOHANG) == acqpid) {
+      acqpid = 0;
+      return WIFEXITED(status) ? WEXITSTATUS(status) : -1; }
+    usleep(10000);
+  }
+  fprintf(stderr, "netscope %d does not stop, killing it\n", acqpid);
+  kill(acqpid, SIGKILL);
+  waitpid(acqpid, &status, 0);
+  acqpid = 0;
+  return -1;
+}
+
+/*
+ * write init sequence to ADCs in mask
+ * return mask of ADCs with mismatching registers, -1 on SPI error
+ */
+int adcinit(unsigned mask) {
+  uint8_t rb[ADC_NINIT_REGS];
+  int adc, res = 0;
+
+  spi_failed = 0;
+  for(adc = 0; adc < SHWR_RAW_NCH_MAX; adc++) {
+    if(!(mask & (1 << adc)))
+      continue;
+    if(adcfd[adc] < 0)
+      return -1;
+    if(adc_write_regs(adcfd[adc], adc_init_regs, ADC_NINIT_REGS, rb) > 0)
+      res |= 1 << adc;
+  }
+  return spi_failed ? -1 : res;
+}
+
+/*
+ * set test mode of chans of ADCs in mask, return 0, -1 on SPI error
+ */
+int adcramp(unsigned mask, int chans, int mode) {
+  int adc;
+
+  spi_failed = 0;
+  for(adc = 0; adc < SHWR_RAW_NCH_MAX; adc++)
+    if(mask & (1 << adc))
+      if(adcfd[adc] < 0 || adc_testmode(adcfd[adc], chans, mode) < 0)
+	spi_failed = 1;
+  return spi_failed ? -1 : 0;
+}
+
+/*
+ * ramp check as adc_check_ramp -n nshots
+ * return mask of failing ADCs, -1 on error (SPI, no trace)
+ */
+int rampcheck(int nshots) {
+  struct itimerspec ts = { { 0, 0 }, { SHOT_TIMEOUT, 0 } };
+  struct shwr_header sh;
+  uint32_t saved_trigger, *databuf;
+  int shot, tfd, evt, res = 0;
+
+  databuf = (uint32_t*)(((((uintptr_t)_databuf + 7) >> 3) << 3) + 4);
+  if((tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC)) < 0)
+    return -1;
+  /* drop traces triggered since the last check */
+  while(read_evt_header(&sh) == 0)
+    read_evt_release(sh.rd);
+  saved_trigger = gl.regs[SHWR_BUF_TRIG_MASK_ADDR];
+  gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = SHWR_BUF_TRIG_LED;
+  gl.tstctl_regs[USE_FAKE_ADDR] |= 1 << USE_FAKE_PPS_BIT;
+  if(adcramp(ADC_ALL, ADC_CHS_AB, ADC_TEST_RAMP) < 0)
+    res = -1;
+  read_evt_arm(1);
+
+  ramp_stats_init(rstats);
+  for(shot = 0; shot < nshots && res >= 0; shot++) {
+    LED_trigger();
+    timerfd_settime(tfd, 0, &ts, NULL);
+    do
+      evt = read_evt_wait(-1, -1, tfd);
+    while(evt == 0);
+    if(evt < 0 || !(evt & EVT_DATA)) {
+      fprintf(stderr, "no ramp trace in shot %d\n", shot);
+      res = -1;
+      break; }
+    if(read_evt_read(&sh, (uint8_t *)databuf) < 0) {
+      fprintf(stderr, "read evt error in shot %d\n", shot);
+      res = -1;
+      break; }
+    ramp_traces(databuf, &sh, traces);
+    res |= evaluate_ramp(traces, shot, rstats);
+  }
+  if(verbose || res > 0)
+    report_ramp(rstats, shot, verbose);
+
+  read_evt_arm(0);
+  if(adcramp(ADC_ALL, ADC_CHS_AB, ADC_TEST_OFF) < 0)
+    res = -1;
+  gl.regs[SHWR_BUF_TRIG_MASK_ADDR] = saved_trigger;
+  close(tfd);
+  return res;
+}
+
+/*
+ * start netscope with NUL separated arguments in args of len bytes
+ * return its pid, -1 on error
+ */
+int startacq(char *args, int len) {
+  char *argv[ACQ_MAXARGS + 2];
+  int argc = 0;
+  char *p;
+
+  argv[argc++] = nspath;
+  args[len] = '\0';
+  for(p = args; p < args + len && *p != '\0'; p += strlen(p) + 1) {
+    if(argc > ACQ_MAXARGS)
+      return -1;
+    argv[argc++] = p; }
+  argv[argc] = NULL;
+  return runchild(argv, 0);
+}
+
+/*
+ * read and execute a command from control socket, reply to the sender
+ * return 1 if the agent is to quit, 0 otherwise
+ */
+int controlrecv(int sock) {
+  struct sockaddr_in src_addr;
+  socklen_t addrlen = sizeof(src_addr);
+  uint32_t buf[MSGSIZE / sizeof(uint32_t) + 1];
+  uint32_t cmd, nargs, status = AGENT_EINVAL;
+  uint32_t *args = buf + 1;
+  char *jcargv[3] = { jcpath, NULL, NULL };
+  ssize_t msglen;
+  int ch, res, stop = 0, nreply = 2;
+
+  msglen = recvfrom(sock, (void *)buf, MSGSIZE, 0,
+		    (struct sockaddr *)&src_addr, &addrlen);
+  if(msglen < (ssize_t)sizeof(uint32_t) || msglen % sizeof(uint32_t))
+    return 0;
+  cmd = buf[0];
+  nargs = msglen / sizeof(uint32_t) - 1;
+  reapacq();
+
+  switch(cmd) {
+  case AGENT_PING:
+    if(nargs == 0) {
+      buf[2] = AGENT_PROTO;
+      buf[3] = acqpid;
+      nreply = 4;
+      status = AGENT_OK; }
+    break;
+  case AGENT_ADCINIT:
+    if(nargs > 1)
+      break;
+    if((res = adcinit(nargs ? args[0] : ADC_ALL)) < 0)
+      status = AGENT_EIO;
+    else {
+      buf[2] = res;
+      nreply = 3;
+      status = AGENT_OK; }
+    break;
+  case AGENT_RAMP:
+    if(nargs < 1 || nargs > 3)
+      break;
+    status = adcramp(nargs > 1 ? args[1] : ADC_ALL,
+		     nargs > 2 ? args[2] : ADC_CHS_AB,
+		     args[0] ? ADC_TEST_RAMP : ADC_TEST_OFF) < 0
+      ? AGENT_EIO : AGENT_OK;
+    break;
+  case AGENT_RAMPCHECK:
+    if(nargs > 1 || (nargs == 1 && (args[0] < 1 || args[0] > MAXSHOTS)))
+      break;
+    if(acqpid > 0)
+      status = AGENT_EBUSY;
+    else if((res = rampcheck(nargs ? args[0] : 1)) < 0)
+      status = AGENT_EIO;
+    else {
+      buf[2] = res;
+      for(ch = 0; ch < SHWR_NCH_MAX; ch++)
+	buf[3 + ch] = rstats[ch].badshots;
+      nreply = 3 + SHWR_NCH_MAX;
+      status = AGENT_OK; }
+    break;
+  case AGENT_JCINIT:
+  case AGENT_JCVERIFY:
+    if(nargs > (cmd == AGENT_JCINIT))
+      break;
+    if(cmd == AGENT_JCVERIFY)
+      jcargv[1] = "-C";
+    else if(nargs && args[0])
+      jcargv[1] = "-c";
+    if((res = runchild(jcargv, 1)) < 0)
+      status = AGENT_ECHILD;
+    else {
+      buf[2] = res;
+      nreply = 3;
+      status = AGENT_OK; }
+    break;
+  case AGENT_ACQSTART:
+    if(acqpid > 0)
+      status = AGENT_EBUSY;
+    else if((res = startacq((char *)args, nargs * sizeof(uint32_t))) < 0)
+      status = AGENT_ECHILD;
+    else {
+      acqpid = res;
+      buf[2] = res;
+      nreply = 3;
+      status = AGENT_OK; }
+    break;
+  case AGENT_ACQSTOP:
+    if(nargs != 0)
+      break;
+    if(acqpid == 0)
+      status = AGENT_EBUSY;
+    else {
+      buf[2] = stopacq();
+      nreply = 3;
+      status = AGENT_OK; }
+    break;
+  case AGENT_QUIT:
+    if(nargs == 0) {
+      stop = 1;
+      status = AGENT_OK; }
+    break;
+  }
+  if(verbose)
+    fprintf(stderr, "command %u, %u args: status %u\n", cmd, nargs, status);
+
+  buf[0] = cmd | AGENT_REPLY;
+  buf[1] = status;
+  sendto(sock, buf, nreply*sizeof(uint32_t), MSG_DONTWAIT,
+	 (struct sockaddr *)&src_addr, addrlen);
+  return stop;
+}
+
+int main(int argc, char **argv) {
+  struct pollfd pfd;
+  int i, opt, sock, port = AGENTPORT;
+
+  while ((opt = getopt(argc, argv, "p:n:j:vVh")) != -1) {
+    switch(opt) {
+    case 'p':
+      port = atoi(optarg);
+      if(port <= 0 || port >= 0x10000) {
+	fprintf(stderr, "Invalid port %s\n", optarg);
+	exit(1); }
+      break;
+    case 'n':
+      nspath = optarg;
+      break;
+    case 'j':
+      jcpath = optarg;
+      break;
+    case 'v':
+      verbose = 1;
+      break;
+    case 'V':
+      fprintf(stderr, "%s v" VERSION "\n", argv[0]);
+      exit(0);
+    case 'h':
+    default:
+      printhelp(argv[0]);
+      exit(1);
+    }}
+
+  sock = opencontrolsock(port);
+  /* hardware mapped and opened once, failing ADCs fail their commands */
+  spi_error = spi_report;
+  for(i = 0; i < SHWR_RAW_NCH_MAX; i++) {
+    if((adcfd[i] = openspidev(i)) >= 0 && spi_init(adcfd[i]) < 0) {
+      close(adcfd[i]);
+      adcfd[i] = -1; }
+    if(adcfd[i] >= 0)
+      fcntl(adcfd[i], F_SETFD, FD_CLOEXEC); }
+  if(read_evt_init(NULL, 0) != 0)
+    exit(1);
+  fcntl(gl.evtfd, F_SETFD, FD_CLOEXEC);
+  read_evt_arm(0);  /* polled only during ramp check */
+
+  signal(SIGINT, sigquit);
+  signal(SIGTERM, sigquit);
+  fprintf(stderr, "uubagent listening on UDP port %d\n", port);
+
+  pfd.fd = sock;
+  pfd.events = POLLIN;
+  while(!quit) {
+    if(poll(&pfd, 1, POLLPERIOD) > 0 && (pfd.revents & POLLIN)
+       && controlrecv(sock))
+      break;
+    reapacq();
+  }
+
+  if(acqpid > 0)
+    stopacq();
+  read_evt_end();
+  for(i = 0; i < SHWR_RAW_NCH_MAX; i++)
+    if(adcfd[i] >= 0)
+      close(adcfd[i]);
+  close(sock);
+  return 0;
+}